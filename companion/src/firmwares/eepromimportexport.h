@@ -23,9 +23,130 @@
 
 #include "customdebug.h"
 #include <QtCore>
-#include <QBitArray>
+#include <algorithm>
 #include <utility>
 
+/*
+ * Read-only view on a little-endian bit stream stored in 64-bit words.
+ * Bit i of the stream is bit i%8 of byte i/8 of the original data.
+ * Sub-views share the storage, fields are read at their offset without copy.
+ * Bits past the end of the view read as 0.
+ */
+class BitReader {
+  public:
+    explicit BitReader(const QByteArray & bytes):
+      storage(new QVector<quint64>((bytes.size() + 7) / 8 + 1, 0)),
+      offset(0),
+      length(bytes.size() * 8)
+    {
+      memcpy(storage->data(), bytes.constData(), bytes.size());
+      for (quint64 & word: *storage)
+        word = qFromLittleEndian(word);
+    }
+
+    inline unsigned int size() const
+    {
+      return length;
+    }
+
+    // n <= 64
+    quint64 read(unsigned int pos, unsigned int n) const
+    {
+      if (pos >= length || n == 0)
+        return 0;
+      if (n > length - pos)
+        n = length - pos;
+
+      unsigned int bit = offset + pos;
+      const quint64 * words = storage->constData() + bit / 64;
+      unsigned int shift = bit % 64;
+      quint64 value = words[0] >> shift;
+      if (shift && shift + n > 64)
+        value |= words[1] << (64 - shift);
+      return n == 64 ? value : value & ((quint64(1) << n) - 1);
+    }
+
+    inline bool operator[](unsigned int pos) const
+    {
+      return read(pos, 1);
+    }
+
+    BitReader slice(unsigned int pos, unsigned int n) const
+    {
+      BitReader result(*this);
+      result.offset = offset + std::min(pos, length);
+      result.length = std::min(n, length - std::min(pos, length));
+      return result;
+    }
+
+  protected:
+    QSharedPointer<QVector<quint64>> storage;
+    unsigned int offset;
+    unsigned int length;
+};
+
+/*
+ * Growable little-endian bit stream stored in 64-bit words, see BitReader.
+ */
+class BitWriter {
+  public:
+    BitWriter():
+      length(0)
+    {
+    }
+
+    inline unsigned int size() const
+    {
+      return length;
+    }
+
+    // n <= 64, bits of value above n are ignored
+    void append(quint64 value, unsigned int n)
+    {
+      if (n == 0)
+        return;
+      if (n < 64)
+        value &= (quint64(1) << n) - 1;
+
+      unsigned int shift = length % 64;
+      if (shift == 0)
+        words.append(value);
+      else {
+        words.last() |= value << shift;
+        if (shift + n > 64)
+          words.append(value >> (64 - shift));
+      }
+      length += n;
+    }
+
+    // truncates or pads with 0 bits
+    void resize(unsigned int n)
+    {
+      if (n > length) {
+        while (length < n)
+          append(0, std::min(64u, n - length));
+        return;
+      }
+      length = n;
+      words.resize((n + 63) / 64);
+      if (n % 64)
+        words.last() &= (quint64(1) << (n % 64)) - 1;
+    }
+
+    QByteArray toBytes() const
+    {
+      QByteArray bytes((length + 7) / 8, 0);
+      for (int i = 0; i < bytes.size(); i++) {
+        bytes[i] = char(words[i / 8] >> (8 * (i % 8)));
+      }
+      return bytes;
+    }
+
+  protected:
+    QVector<quint64> words;
+    unsigned int length;
+};
+
 class DataField {
   Q_DECLARE_TR_FUNCTIONS(DataField)
 
@@ -45,42 +166,21 @@ class DataField {
     }
 
     virtual unsigned int size() = 0; // size in bits
-    virtual void ExportBits(QBitArray & output) = 0;
-    virtual void ImportBits(const QBitArray & input) = 0;
-
-    static QBitArray bytesToBits(QByteArray bytes)
-    {
-      QBitArray bits(bytes.count()*8);
-      // Convert from QByteArray to QBitArray
-      for (int i=0; i<bytes.count(); ++i)
-        for (int b=0; b<8; ++b)
-          bits.setBit(i*8+b, bytes.at(i)&(1<<b));
-      return bits;
-    }
-
-    static QByteArray bitsToBytes(QBitArray bits, int offset=0)
-    {
-      QByteArray bytes;
-      bytes.resize((offset+bits.count()+7)/8);
-      bytes.fill(0);
-      // Convert from QBitArray to QByteArray
-      for (int b=0; b<bits.count(); ++b)
-        bytes[(b+offset)/8] = ( bytes.at((b+offset)/8) | ((bits[b]?1:0)<<((b+offset)%8)));
-      return bytes;
-    }
+    virtual void ExportBits(BitWriter & output) = 0;
+    virtual void ImportBits(const BitReader & input) = 0;
 
     int Export(QByteArray & output)
     {
-      QBitArray result;
+      BitWriter result;
       ExportBits(result);
-      output = bitsToBytes(result);
+      output = result.toBytes();
       return 0;
     }
 
     int Import(const QByteArray & input)
     {
-      QBitArray bits = bytesToBits(input);
-      if (unsigned(bits.size()) < size()) {
+      BitReader bits(input);
+      if (bits.size() < size()) {
         qDebug() << QString("Error importing %1: size too small %2 bits / %3 bits").arg(getName()).arg(bits.size()).arg(size());
         return -1;
       }
@@ -90,15 +190,15 @@ class DataField {
 
     virtual int dump(int level=0, int offset=0)
     {
-      QBitArray bits;
+      BitWriter bits;
       ExportBits(bits);
-      QByteArray bytes = bitsToBytes(bits);
-      int result = (offset+bits.count()) % 8;
+      QByteArray bytes = bits.toBytes();
+      int result = (offset+bits.size()) % 8;
       for (int i=0; i<level; i++) printf("  ");
-      if (bits.count() % 8 == 0)
+      if (bits.size() % 8 == 0)
         printf("%s (%dbytes) ", getName().toLatin1().constData(), bytes.count());
       else
-        printf("%s (%dbits) ", getName().toLatin1().constData(), bits.count());
+        printf("%s (%dbits) ", getName().toLatin1().constData(), bits.size());
       for (int i=0; i<bytes.count(); i++) {
         unsigned char c = bytes[i];
         if ((i==0 && offset) || (i==bytes.count()-1 && result!=0))
@@ -165,27 +265,20 @@ class BaseUnsignedField: public DataField {
 
     BaseUnsignedField() = delete;
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
       container value = field;
       if (value > max) value = max;
       if (value < min) value = min;
 
-      output.resize(N);
-      for (int i=0; i<N; i++) {
-        if (value & ((container)1<<i)) {
-          output.setBit(i);
-        }
+      for (int i=0; i<N; i+=64) {
+        output.append(i < int(8*sizeof(container)) ? quint64(value) >> i : 0, std::min(64, N-i));
       }
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
-      field = 0;
-      for (int i=0; i<N; i++) {
-        if (input[i])
-          field |= ((container)1<<i);
-      }
+      field = (container)input.read(0, std::min<int>(N, 8*sizeof(container)));
       qCDebug(eepromImport) << QString("\timported %1<%2>: 0x%3(%4)").arg(name).arg(N).arg(field, 0, 16).arg(field);
     }
 
@@ -231,15 +324,13 @@ class BoolField: public DataField {
 
     BoolField() = delete;
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
-      output.resize(N);
-      if (field) {
-        output.setBit(0);
-      }
+      output.append(field ? 1 : 0, 1);
+      output.resize(output.size() + N - 1);
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
       field = input[0];
       qCDebug(eepromImport) << QString("\timported %1<%2>: 0x%3(%4)").arg(name).arg(N).arg(field, 0, 16).arg(field);
@@ -277,31 +368,21 @@ class SignedField: public DataField {
     {
     }
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
       int value = field;
       if (value > max) value = max;
       if (value < min) value = min;
 
-      output.resize(N);
-      for (int i=0; i<N; i++) {
-        if (((unsigned int)value) & (1<<i))
-          output.setBit(i);
-      }
+      output.append((unsigned int)value, N);
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
-      unsigned int value = 0;
-      for (int i=0; i<N; i++) {
-        if (input[i])
-          value |= (1<<i);
-      }
+      unsigned int value = input.read(0, N);
 
-      if (input[N-1]) {
-        for (unsigned int i=N; i<8*sizeof(int); i++) {
-          value |= (1<<i);
-        }
+      if (N < 8*sizeof(int) && input[N-1]) {
+        value |= ~0u << (N % (8*sizeof(int)));
       }
 
       field = (int)value;
@@ -342,30 +423,18 @@ class CharField: public DataField {
     {
     }
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
-      output.resize(N*8);
-      int b = 0;
       int len = truncate ? strlen(field) : N;
       for (int i=0; i<N; i++) {
-        int idx = (i>=len ? 0 : field[i]);
-        for (int j=0; j<8; j++, b++) {
-          if (idx & (1<<j))
-            output.setBit(b);
-        }
+        output.append(i>=len ? 0 : (uint8_t)field[i], 8);
       }
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
-      unsigned int b = 0;
       for (int i=0; i<N; i++) {
-        int8_t idx = 0;
-        for (int j=0; j<8; j++) {
-          if (input[b++])
-            idx |= (1<<j);
-        }
-        field[i] = idx;
+        field[i] = (int8_t)input.read(i*8, 8);
       }
       qCDebug(eepromImport) << QString("\timported %1<%2>: '%3'").arg(name).arg(N).arg(field);
     }
@@ -417,30 +486,18 @@ class ZCharField: public DataField {
     {
     }
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
-      output.resize(N*8);
-      int b = 0;
       int len = strlen(field);
       for (int i=0; i<N; i++) {
-        int idx = i>=len ? 0 : char2zchar(field[i]);
-        for (int j=0; j<8; j++, b++) {
-          if (idx & (1<<j))
-            output.setBit(b);
-        }
+        output.append(i>=len ? 0 : (uint8_t)char2zchar(field[i]), 8);
       }
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
-      unsigned int b = 0;
       for (int i=0; i<N; i++) {
-        int8_t idx = 0;
-        for (int j=0; j<8; j++) {
-          if (input[b++])
-            idx |= (1<<j);
-        }
-        field[i] = zchar2char(idx);
+        field[i] = zchar2char((int8_t)input.read(i*8, 8));
       }
 
       field[N] = '\0';
@@ -480,29 +537,24 @@ class StructField: public DataField {
       fields.append(field);
     }
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
-      int offset = 0;
-      output.resize(size());
+      unsigned int start = output.size();
       foreach(DataField *field, fields) {
-        QBitArray bits;
-        field->ExportBits(bits);
-        for (int i=0; i<bits.size(); i++)
-          output[offset++] = bits[i];
+        field->ExportBits(output);
       }
+      output.resize(start + size());
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
       qCDebug(eepromImport) << QString("\timporting %1[%2]:").arg(name).arg(fields.size());
-      int offset = 0;
+      unsigned int offset = 0;
       foreach(DataField *field, fields) {
+        // the size may depend on the fields imported before
         unsigned int size = field->size();
-        QBitArray bits(size);
-        for (unsigned int i=0; i<size; i++) {
-          bits[i] = input[offset++];
-        }
-        field->ImportBits(bits);
+        field->ImportBits(input.slice(offset, size));
+        offset += size;
       }
     }
 
@@ -540,13 +592,13 @@ class TransformedField: public DataField {
     ~TransformedField() override
     = default;
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
       beforeExport();
       field.ExportBits(output);
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
       qCDebug(eepromImport) << QString("\timporting TransformedField %1:").arg(field.getName());
       field.ImportBits(input);
@@ -619,18 +671,19 @@ class UnionField: public DataField {
         maxSize = member->getField()->size();
     }
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
+      unsigned int start = output.size();
       foreach(UnionMember *member, members) {
         if (member->select(selectField)) {
           member->getField()->ExportBits(output);
           break;
         }
       }
-      output.resize(maxSize);
+      output.resize(start + maxSize);
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
       foreach(UnionMember *member, members) {
         if (member->select(selectField)) {
@@ -1714,7 +1714,7 @@ class FrskyScreenField: public DataField {
         none.Append(new SpareBitsField<20*8>(this));
     }
 
-    void ExportBits(QBitArray & output) override
+    void ExportBits(BitWriter & output) override
     {
       if (screen.type == TELEMETRY_SCREEN_SCRIPT)
         script.ExportBits(output);
@@ -1726,7 +1726,7 @@ class FrskyScreenField: public DataField {
         none.ExportBits(output);
     }
 
-    void ImportBits(const QBitArray & input) override
+    void ImportBits(const BitReader & input) override
     {
       qCDebug(eepromImport) << QString("importing %1: type: %2").arg(name).arg(screen.type);
 
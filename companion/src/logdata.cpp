@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "logdata.h"
+
+#include <QDateTime>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QVarLengthArray>
+#include <algorithm>
+#include <string.h>
+
+#define LOG_PARSE_CHUNK   4096  // rows per parser job
+
+class LogParseRunnable : public QRunnable
+{
+  public:
+    LogParseRunnable(LogData * log, int first, int last) :
+      log(log),
+      first(first),
+      last(last)
+    {
+    }
+
+    void run() override
+    {
+      log->parseRows(first, last);
+    }
+
+  protected:
+    LogData * log;
+    int first;
+    int last;
+};
+
+static inline bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static inline double parseDouble(const char * str, int len)
+{
+  // QByteArray::toDouble() always uses the C locale, as QString::toDouble() did
+  return QByteArray::fromRawData(str, len).toDouble();
+}
+
+static bool parseDigits(const char * str, int len, int & value)
+{
+  value = 0;
+  for (int i = 0; i < len; i++) {
+    if (str[i] < '0' || str[i] > '9')
+      return false;
+    value = value * 10 + (str[i] - '0');
+  }
+  return true;
+}
+
+static double parseTimeOfDay(const char * str, int len, bool & ok)
+{
+  // HH:mm:ss[.zzz]
+  int h, m, s;
+  ok = len >= 8 && str[2] == ':' && str[5] == ':' &&
+       parseDigits(str, 2, h) && parseDigits(str + 3, 2, m) && parseDigits(str + 6, 2, s) &&
+       (len == 8 || str[8] == '.');
+  if (!ok)
+    return 0;
+  double result = h * 3600 + m * 60 + s;
+  if (len > 8)
+    result += parseDouble(str + 8, len - 8);
+  return result;
+}
+
+LogData::LogData() :
+  data(nullptr),
+  headerLength(0),
+  errors(0),
+  lines(0)
+{
+}
+
+LogData::~LogData()
+{
+  // unmapped by QFile::close()
+  file.close();
+}
+
+bool LogData::load(const QString & fileName)
+{
+  file.setFileName(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  const qint64 size = file.size();
+  data = size > 0 ? (const char *)file.map(0, size) : nullptr;
+  if (!data) {
+    buffer = file.readAll();
+    data = buffer.constData();
+  }
+
+  const char * end = data + size;
+  const char * pos = data;
+  int numfields = -1;
+
+  while (pos < end) {
+    const char * eol = (const char *)memchr(pos, '\n', end - pos);
+    if (!eol)
+      eol = end;
+    const char * first = pos;
+    const char * last = eol;
+    while (first < last && isBlank(*first))
+      first++;
+    while (last > first && isBlank(*(last - 1)))
+      last--;
+    pos = eol + 1;
+
+    int fields = std::count(first, last, ',') + 1;
+    if (numfields == -1) {
+      if (last - first < 9 || strncmp(first, "Date,Time", 9))
+        return false;
+      numfields = fields;
+      headerLength = last - first;
+      headers = QString::fromUtf8(first, last - first).split(',');
+      continue;
+    }
+
+    lines++;
+    if (fields == numfields) {
+      rowStart.append(first - data);
+      rowLength.append(last - first);
+    }
+    else {
+      errors++;
+    }
+  }
+
+  if (rowStart.isEmpty())
+    return false;
+
+  times.resize(rowStart.size());
+  columns.resize(numfields);
+  for (int col = 2; col < numfields; col++) {
+    columns[col].resize(rowStart.size());
+  }
+
+  // detach everything here, the parser jobs only write to disjoint row ranges
+  times.data();
+  for (int col = 2; col < numfields; col++) {
+    columns[col].data();
+  }
+
+  QThreadPool pool;
+  for (int row = 0; row < rowStart.size(); row += LOG_PARSE_CHUNK) {
+    pool.start(new LogParseRunnable(this, row, qMin(row + LOG_PARSE_CHUNK, rowStart.size())));
+  }
+  pool.waitForDone();
+
+  return true;
+}
+
+void LogData::parseRows(int first, int last)
+{
+  const int numfields = columns.size();
+  double * timeValues = times.data();
+  QVarLengthArray<double *, 64> values(numfields);
+  for (int col = 2; col < numfields; col++) {
+    values[col] = columns[col].data();
+  }
+
+  // the date seldom changes, keep the last one converted
+  QByteArray lastDate;
+  double lastDateTime = 0;
+
+  for (int row = first; row < last; row++) {
+    const char * pos = data + rowStart.at(row);
+    const char * end = pos + rowLength.at(row);
+    const char * date = pos;
+    int dateLength = 0;
+
+    for (int col = 0; col < numfields; col++) {
+      const char * sep = (const char *)memchr(pos, ',', end - pos);
+      if (!sep)
+        sep = end;
+      int len = sep - pos;
+
+      if (col == 0) {
+        dateLength = len;
+      }
+      else if (col == 1) {
+        bool ok = false;
+        double seconds = parseTimeOfDay(pos, len, ok);
+        if (ok) {
+          if (lastDate.size() != dateLength || memcmp(lastDate.constData(), date, dateLength)) {
+            lastDate = QByteArray(date, dateLength);
+            lastDateTime = QDateTime(QDate::fromString(QString::fromLatin1(lastDate), "yyyy-MM-dd"), QTime(0, 0)).toTime_t();
+          }
+          timeValues[row] = lastDateTime + seconds;
+        }
+        else {
+          timeValues[row] = QDateTime::fromString(QString::fromLatin1(date, dateLength) + " " + QString::fromLatin1(pos, len), "yyyy-MM-dd HH:mm:ss").toTime_t();
+        }
+      }
+      else {
+        values[col][row] = parseDouble(pos, len);
+      }
+
+      pos = sep + 1;
+    }
+  }
+}
+
+QString LogData::text(int row, int column) const
+{
+  const char * pos = data + rowStart.at(row);
+  const char * end = pos + rowLength.at(row);
+
+  for (int col = 0; col < column; col++) {
+    pos = (const char *)memchr(pos, ',', end - pos) + 1;
+  }
+
+  const char * sep = (const char *)memchr(pos, ',', end - pos);
+  return QString::fromUtf8(pos, (sep ? sep : end) - pos);
+}
+
+QByteArray LogData::line(int row) const
+{
+  return QByteArray(data + rowStart.at(row), rowLength.at(row));
+}
+
+QByteArray LogData::headerLine() const
+{
+  const char * first = data;
+  while (isBlank(*first))
+    first++;
+  return QByteArray(first, headerLength);
+}
+
+LogTableModel::LogTableModel(QObject * parent) :
+  QAbstractTableModel(parent),
+  logData(new LogData())
+{
+}
+
+bool LogTableModel::load(const QString & fileName)
+{
+  QScopedPointer<LogData> newData(new LogData());
+  if (!newData->load(fileName))
+    return false;
+
+  beginResetModel();
+  logData.swap(newData);
+  endResetModel();
+  return true;
+}
+
+int LogTableModel::rowCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : logData->rowCount();
+}
+
+int LogTableModel::columnCount(const QModelIndex & parent) const
+{
+  return parent.isValid() ? 0 : logData->columnCount();
+}
+
+QVariant LogTableModel::data(const QModelIndex & index, int role) const
+{
+  if (!index.isValid() || role != Qt::DisplayRole)
+    return QVariant();
+
+  return logData->text(index.row(), index.column());
+}
+
+QVariant LogTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  if (role != Qt::DisplayRole)
+    return QVariant();
+
+  if (orientation == Qt::Horizontal)
+    return logData->header().value(section);
+
+  return section + 1;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _LOGDATA_H_
+#define _LOGDATA_H_
+
+#include <QAbstractTableModel>
+#include <QFile>
+#include <QScopedPointer>
+#include <QStringList>
+#include <QVector>
+
+/*
+  Telemetry log (CSV) kept as columns of doubles.
+
+  The file stays memory mapped for the lifetime of the object: only line
+  offsets and the parsed numeric values are stored, cell texts are extracted
+  from the mapping on demand. Columns 0 and 1 (Date and Time) are merged into
+  a single time column holding seconds since the epoch (local time).
+*/
+class LogData
+{
+  public:
+    LogData();
+    ~LogData();
+
+    bool load(const QString & fileName);
+
+    int rowCount() const { return rowStart.size(); }
+    int columnCount() const { return headers.size(); }
+    const QStringList & header() const { return headers; }
+    int invalidLines() const { return errors; }
+    int totalLines() const { return lines; }
+
+    double time(int row) const { return times.at(row); }
+    const QVector<double> & timeColumn() const { return times; }
+    // numeric values of a data column (column >= 2)
+    const QVector<double> & column(int column) const { return columns.at(column); }
+
+    QString text(int row, int column) const;
+    QByteArray line(int row) const;
+    QByteArray headerLine() const;
+
+  private:
+    friend class LogParseRunnable;
+
+    void parseRows(int first, int last);
+
+    QFile file;
+    QByteArray buffer;  // used when the file can't be mapped
+    const char * data;
+    QStringList headers;
+    int headerLength;
+    QVector<qint64> rowStart;
+    QVector<int> rowLength;
+    QVector<double> times;
+    QVector<QVector<double>> columns;
+    int errors;
+    int lines;
+};
+
+class LogTableModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+  public:
+    explicit LogTableModel(QObject * parent = nullptr);
+
+    bool load(const QString & fileName);
+    const LogData & log() const { return *logData; }
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+  private:
+    QScopedPointer<LogData> logData;
+};
+
+#endif // _LOGDATA_H_
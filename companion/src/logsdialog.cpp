@@ -19,6 +19,7 @@
  */
 
 #include <math.h>
+#include <algorithm>
 #include "logsdialog.h"
 #include "appdata.h"
 #include "ui_logsdialog.h"
@@ -37,11 +38,12 @@ LogsDialog::LogsDialog(QWidget *parent) :
   cursorB(0),
   cursorLine(0)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
 
+  logModel = new LogTableModel(this);
+  ui->logTable->setModel(logModel);
+
   plotLock=false;
 
   colors.append(Qt::green);
@@ -110,13 +112,15 @@ LogsDialog::LogsDialog(QWidget *parent) :
 
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), SIGNAL(rangeChanged(QCPRange)), this, SLOT(yAxisChangeRanges(QCPRange)));
+  // resample the graphs for the visible time range:
+  connect(axisRect->axis(QCPAxis::atBottom), SIGNAL(rangeChanged(QCPRange)), this, SLOT(xAxisChangeRange(QCPRange)));
 
   // connect some interaction slots:
   connect(ui->customPlot, SIGNAL(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)), this, SLOT(titleDoubleClick(QMouseEvent*, QCPPlotTitle*)));
   connect(ui->customPlot, SIGNAL(axisDoubleClick(QCPAxis*,QCPAxis::SelectablePart,QMouseEvent*)), this, SLOT(axisLabelDoubleClick(QCPAxis*,QCPAxis::SelectablePart)));
   connect(ui->customPlot, SIGNAL(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*,QMouseEvent*)), this, SLOT(legendDoubleClick(QCPLegend*,QCPAbstractLegendItem*)));
   connect(ui->FieldsTW, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
-  connect(ui->logTable, SIGNAL(itemSelectionChanged()), this, SLOT(plotLogs()));
+  connect(ui->logTable->selectionModel(), SIGNAL(selectionChanged(QItemSelection, QItemSelection)), this, SLOT(plotLogs()));
   connect(ui->Reset_PB, SIGNAL(clicked()), this, SLOT(plotLogs()));
   connect(ui->SaveSession_PB, SIGNAL(clicked()), this, SLOT(saveSession()));
 }
@@ -236,84 +240,99 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QVector<int> LogsDialog::selectedLogRows()
+{
+  QVector<int> rows;
+
+  foreach (const QItemSelectionRange & range, ui->logTable->selectionModel()->selection()) {
+    for (int row = range.top(); row <= range.bottom(); row++) {
+      rows.append(row);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+  return rows;
+}
+
+QVector<int> LogsDialog::filterGePoints()
 {
-  QList<QStringList> result;
+  QVector<int> result;
+  const LogData & log = logModel->log();
 
-  int n = input.count();
+  int n = log.rowCount();
   if (n == 0) {
     return result;
   }
 
-  int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
-      gpscol=i;
-    }
-  }
-  if (gpscol == 0) {
+  int gpscol = log.header().lastIndexOf("GPS");
+  if (gpscol <= 0) {
     QMessageBox::critical(this, tr("Error: no GPS data found"),
       tr("The column containing GPS coordinates must be named \"GPS\".\n\n\
 The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  QVector<int> rows = selectedLogRows();
+  if (rows.isEmpty()) {
+    rows.resize(n);
+    for (int i = 0; i < n; i++) {
+      rows[i] = i;
+    }
+  }
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
-
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
-
-      // glitch filter
-      if ( glitchFilter.isGlitch(coord) ) {
-        // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
+  foreach (int row, rows) {
+    GpsCoord coord = extractGpsCoordinates(log.text(row, gpscol));
 
-      // lat long pair filter
-      if ( !latLonFilter.isValid(coord) ) {
-        // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
+    // glitch filter
+    if ( glitchFilter.isGlitch(coord) ) {
+      // qDebug() << "filterGePoints(): GPS glitch detected at" << row << coord.latitude << coord.longitude;
+      continue;
+    }
 
-      // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+    // lat long pair filter
+    if ( !latLonFilter.isValid(coord) ) {
+      // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << row << coord.latitude << coord.longitude;
+      continue;
     }
+
+    // qDebug() << "point " << latitude << longitude;
+    result.append(row);
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << rows.count() << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
-  int n = dataPoints.count(); // number of points to export
-  if (n==0) return;
+  QVector<int> dataPoints = filterGePoints();
+  if (dataPoints.isEmpty()) return;
+
+  const LogData & log = logModel->log();
+  const QStringList & header = log.header();
 
   int gpscol=0, altcol=0, speedcol=0;
   double altMultiplier = 1.0;
 
   QSet<int> nondataCols;
-  for (int i=1; i<dataPoints.at(0).count(); i++) {
+  for (int i=1; i<header.count(); i++) {
     // Long,Lat,Course,GPS Speed,GPS Alt
-    if (dataPoints.at(0).at(i) == "GPS") {
+    if (header.at(i) == "GPS") {
       gpscol=i;
     }
-    if (dataPoints.at(0).at(i).contains("GAlt")) {
+    if (header.at(i).contains("GAlt")) {
       altcol = i;
       nondataCols << i;
-      if (dataPoints.at(0).at(i).contains("(ft)")) {
+      if (header.at(i).contains("(ft)")) {
         altMultiplier = 0.3048;    // feet to meters
       }
     }
-    if (dataPoints.at(0).at(i).contains("GSpd")) {
+    if (header.at(i).contains("GSpd")) {
       speedcol = i;
       nondataCols << i;
     }
@@ -353,9 +372,9 @@ void LogsDialog::exportToGoogleEarth()
   outputStream << "\t\t\t<gx:SimpleArrayField name=\"GPSSpeed\" type=\"float\">\n\t\t\t\t<displayName>GPS Speed</displayName>\n\t\t\t</gx:SimpleArrayField>\n";
 
   // declare additional fields
-  for (int i=0; i<dataPoints.at(0).count()-2; i++) {
+  for (int i=0; i<header.count()-2; i++) {
     if (ui->FieldsTW->item(i, 0) && ui->FieldsTW->item(i, 0)->isSelected() && !nondataCols.contains(i+2)) {
-      QString origName = dataPoints.at(0).at(i+2);
+      QString origName = header.at(i+2);
       QString safeName = origName;
       safeName.replace(" ","_");
       outputStream << "\t\t\t<gx:SimpleArrayField name=\""<< safeName <<"\" ";
@@ -378,17 +397,17 @@ void LogsDialog::exportToGoogleEarth()
   outputStream << "\n\t\t\t\t\t<altitudeMode>absolute</altitudeMode>\n";
 
   // time data points
-  for (int i=1; i<n; i++) {
-    QString tstamp=dataPoints.at(i).at(0)+QString("T")+dataPoints.at(i).at(1)+QString("Z");
+  foreach (int row, dataPoints) {
+    QString tstamp=log.text(row, 0)+QString("T")+log.text(row, 1)+QString("Z");
     outputStream << "\t\t\t\t\t<when>"<< tstamp <<"</when>\n";
   }
 
   // coordinate data points
   outputStream.setRealNumberNotation(QTextStream::FixedNotation);
   outputStream.setRealNumberPrecision(8);
-  for (int i=1; i<n; i++) {
-    GpsCoord coord = extractGpsCoordinates(dataPoints.at(i).at(gpscol));
-    int altitude = altcol ? (dataPoints.at(i).at(altcol).toFloat() * altMultiplier) : 0;
+  foreach (int row, dataPoints) {
+    GpsCoord coord = extractGpsCoordinates(log.text(row, gpscol));
+    int altitude = altcol ? (log.column(altcol).at(row) * altMultiplier) : 0;
     outputStream << "\t\t\t\t\t<gx:coord>" << coord.longitude << " " << coord.latitude << " " << altitude << " </gx:coord>\n" ;
   }
 
@@ -398,20 +417,20 @@ void LogsDialog::exportToGoogleEarth()
   if (speedcol) {
     // gps speed data points
     outputStream << "\t\t\t\t\t\t\t<gx:SimpleArrayData name=\"GPSSpeed\">\n";
-    for (int i=1; i<n; i++) {
-      outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< dataPoints.at(i).at(speedcol) <<"</gx:value>\n";
+    foreach (int row, dataPoints) {
+      outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< log.text(row, speedcol) <<"</gx:value>\n";
     }
     outputStream << "\t\t\t\t\t\t\t</gx:SimpleArrayData>\n";
   }
 
   // add values for additional fields
-  for (int i=0; i<dataPoints.at(0).count()-2; i++) {
+  for (int i=0; i<header.count()-2; i++) {
     if (ui->FieldsTW->item(i, 0) && ui->FieldsTW->item(i, 0)->isSelected() && !nondataCols.contains(i+2)) {
-      QString safeName = dataPoints.at(0).at(i+2);;
+      QString safeName = header.at(i+2);
       safeName.replace(" ","_");
       outputStream << "\t\t\t\t\t\t\t<gx:SimpleArrayData name=\""<< safeName <<"\">\n";
-      for (int j=1; j<n; j++) {
-        outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< dataPoints.at(j).at(i+2) <<"</gx:value>\n";
+      foreach (int row, dataPoints) {
+        outputStream << "\t\t\t\t\t\t\t\t<gx:value>"<< log.text(row, i+2) <<"</gx:value>\n";
       }
       outputStream << "\t\t\t\t\t\t\t</gx:SimpleArrayData>\n";
     }
@@ -572,37 +591,27 @@ void LogsDialog::on_fileOpen_BT_clicked()
     g.logDir(fileName);
     ui->FileName_LE->setText(fileName);
     if (cvsFileParse()) {
+      const QStringList & header = logModel->log().header();
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0,0,0,0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count()-2);
+      ui->FieldsTW->setRowCount(header.count()-2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
-      for (int i=2; i<csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
+      for (int i=2; i<header.count(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(header.at(i));
         ui->FieldsTW->setItem(i-2, 0, item);
       }
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count()-1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
-
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i=1; i<csvlog.count(); i++) {
-        for (int j=0; j<csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
 
+      // the view only sizes the columns from the rows in sight
       ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
       QVarLengthArray<int> sizes;
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
+      for (int i = 0; i < logModel->columnCount(); i++) {
         sizes.append(ui->logTable->columnWidth(i));
       }
       ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
+      for (int i = 0; i < logModel->columnCount(); i++) {
         ui->logTable->setColumnWidth(i, sizes.at(i));
       }
     }
@@ -614,96 +623,47 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    const LogData & log = logModel->log();
+    int first = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int last;
+    if (index < ui->sessions_CB->count() - 1) {
+      last = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
+    } else {
+      last = log.rowCount();
     }
-    // save the filtered records to a new file
+    // save the session records to a new file, they are copied verbatim from the source file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);", 0, 0); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
-      QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      // add CSV headers from first row of source file
+      data.write(log.headerLine());
+      data.write("\n");
+      for(int i = first; i < last; i++){
+        data.write(log.line(i));
+        data.write("\n");
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
 bool LogsDialog::cvsFileParse()
 {
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
-
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  // the model reset clears the rows selection, don't plot the new rows with the old fields
+  plotLock = true;
+  if (!logModel->load(ui->FileName_LE->text())) {
+    plotLock = false;
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
 
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
+  const LogData & log = logModel->log();
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
 
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-      if (numfields==-1) {
-        numfields=columns.count();
-      }
-      if (columns.count()==numfields) {
-        csvlog.append(columns);
-      }
-      else {
-        errors++;
-      }
-      lines++;
-    }
-
-    logFilename = QFileInfo(file.fileName()).baseName();
+  if (log.invalidLines() > 1) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(log.invalidLines()).arg(log.totalLines()));
   }
 
-  file.close();
-  if (errors > 1) {
-    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
-  }
-
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
-    return false;
-  }
-
-  plotLock = true;
   setFlightSessions();
   plotLock = false;
 
@@ -717,10 +677,7 @@ struct FlightSession {
 
 QDateTime LogsDialog::getRecordTimeStamp(int index)
 {
-  QString tstamp = csvlog.at(index).at(0) + " " + csvlog.at(index).at(1);
-  if (csvlog.at(index).at(1).contains("."))
-    return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss.zzz");
-  return QDateTime::fromString(tstamp, "yyyy-MM-dd HH:mm:ss");
+  return QDateTime::fromMSecsSinceEpoch(qRound64(logModel->log().time(index) * 1000));
 }
 
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
@@ -740,35 +697,33 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  const LogData & log = logModel->log();
+  int n = log.rowCount();
   // qDebug() << "records" << n;
 
   // find session breaks
   QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
+  for (int i = 0; i < n; i++) {
+    if (i == 0 || log.time(i) - log.time(i-1) > 60) {
+      sessions.push_back(i);
+      // qDebug() << "session index" << i;
     }
-    lastvalue = tmp;
   }
-  sessions.push_back(n-1);
+  sessions.push_back(n);
 
   //now construct a list of sessions with their times
   //total time
   int noSesions = sessions.size()-1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n-1)) + ">";
+  label += " <" + tr("time span") + generateDuration(getRecordTimeStamp(0), getRecordTimeStamp(n-1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1)+1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i-1));
+      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i)-1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i-1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -788,13 +743,13 @@ void LogsDialog::on_sessions_CB_currentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logModel->rowCount();
     }
 
     QModelIndex topLeft = ui->logTable->model()->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
     QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+      bottom - 1, logModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -818,70 +773,53 @@ void LogsDialog::plotLogs()
     return;
   }
 
-  plotsCollection plots;
+  const LogData & log = logModel->log();
+  QVector<int> selectedRows = selectedLogRows();
+  bool hasLogSelection = !selectedRows.isEmpty();
 
-  QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
-  QVarLengthArray<int> selectedRows;
-
-  if (rowCount) {
-    hasLogSelection = true;
-    foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
+  // the values are shared with the log columns unless a range of rows is selected
+  QVector<double> x;
+  if (hasLogSelection) {
+    x.reserve(selectedRows.size());
+    foreach (int row, selectedRows) {
+      x.append(log.time(row));
     }
-    std::sort(selectedRows.begin(), selectedRows.end());
   } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
+    x = log.timeColumn();
   }
 
+  plots.coords.clear();
   plots.min_x = QDateTime::currentDateTime().toTime_t();
   plots.max_x = 0;
+  foreach (double time, x) {
+    if (plots.min_x > time) plots.min_x = time;
+    if (plots.max_x < time) plots.max_x = time;
+  }
+  plots.sorted_x = std::is_sorted(x.constBegin(), x.constEnd());
 
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
     int plotColumn = plot->row() + 2; // Date and Time first
+    const QVector<double> & values = log.column(plotColumn);
 
     plotCoords.min_y = INVALID_MIN;
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
+    plotCoords.x = x;
 
-    for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QString time_str;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        time_str = ui->logTable->item(selectedRows.at(row), 0)->text() +
-          QString(" ") + ui->logTable->item(selectedRows.at(row), 1)->text();
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        time_str = ui->logTable->item(row, 0)->text() + QString(" ") +
-          ui->logTable->item(row, 1)->text();
+    if (hasLogSelection) {
+      plotCoords.y.reserve(selectedRows.size());
+      foreach (int row, selectedRows) {
+        plotCoords.y.append(values.at(row));
       }
+    } else {
+      plotCoords.y = values;
+    }
 
-      y = logValue->text().toDouble();
-      plotCoords.y.push_back(y);
-
+    foreach (double y, plotCoords.y) {
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
-
-      if (time_str.contains('.')) {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss.zzz")
-          .toTime_t();
-        time += time_str.mid(time_str.indexOf('.')).toDouble();
-      } else {
-        time = QDateTime::fromString(time_str, "yyyy-MM-dd HH:mm:ss")
-          .toTime_t();
-      }
-      plotCoords.x.push_back(time);
-
-      if (plots.min_x > time) plots.min_x = time;
-      if (plots.max_x < time) plots.max_x = time;
     }
 
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
@@ -1045,8 +983,8 @@ void LogsDialog::plotLogs()
         break;
     }
 
-    ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
-      plots.coords.at(i).y);
+    setGraphData(ui->customPlot->graph(i), plots.coords.at(i),
+      axisRect->axis(QCPAxis::atBottom)->range());
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
@@ -1108,6 +1046,58 @@ void LogsDialog::yAxisChangeRanges(QCPRange range)
   }
 }
 
+void LogsDialog::xAxisChangeRange(QCPRange range)
+{
+  int count = qMin(ui->customPlot->graphCount(), plots.coords.size());
+  for (int i = 0; i < count; i++) {
+    setGraphData(ui->customPlot->graph(i), plots.coords.at(i), range);
+  }
+}
+
+void LogsDialog::setGraphData(QCPGraph * graph, const coords_t & c, const QCPRange & range)
+{
+  // QCustomPlot keeps its data in a QMap: only give it the points of the visible range,
+  // reduced to the min and max of each pixel column when there are more than that.
+  // The full series stay in plots for the markers.
+  int first = 0;
+  int last = c.x.size();
+  if (plots.sorted_x) {
+    first = std::lower_bound(c.x.constBegin(), c.x.constEnd(), range.lower) - c.x.constBegin();
+    last = std::upper_bound(c.x.constBegin(), c.x.constEnd(), range.upper) - c.x.constBegin();
+    // keep one point on each side so that the lines reach the plot edges
+    first = qMax(first - 1, 0);
+    last = qMin(last + 1, c.x.size());
+  }
+
+  int count = last - first;
+  int buckets = qMax(axisRect->width(), 100);
+  if (count <= 2 * buckets) {
+    graph->setData(c.x.mid(first, count), c.y.mid(first, count));
+    return;
+  }
+
+  QVector<double> x, y;
+  x.reserve(2 * buckets);
+  y.reserve(2 * buckets);
+  for (int b = 0; b < buckets; b++) {
+    int start = first + (qint64)count * b / buckets;
+    int end = first + (qint64)count * (b + 1) / buckets;
+    int imin = start, imax = start;
+    for (int i = start + 1; i < end; i++) {
+      if (c.y.at(i) < c.y.at(imin)) imin = i;
+      if (c.y.at(i) > c.y.at(imax)) imax = i;
+    }
+    // in time order
+    int i1 = qMin(imin, imax), i2 = qMax(imin, imax);
+    x.append(c.x.at(i1));
+    y.append(c.y.at(i1));
+    if (i2 != i1) {
+      x.append(c.x.at(i2));
+      y.append(c.y.at(i2));
+    }
+  }
+  graph->setData(x, y);
+}
 
 void LogsDialog::addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph) {
   // find max altitude
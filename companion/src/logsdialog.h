@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "logdata.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -61,6 +62,7 @@ class LogsDialog : public QDialog
     QVarLengthArray<coords_t> coords;
     double min_x;
     double max_x;
+    bool sorted_x;
     bool tooManyRanges;
   };
 
@@ -82,14 +84,16 @@ private slots:
   void on_sessions_CB_currentIndexChanged(int index);
   void on_mapsButton_clicked();
   void yAxisChangeRanges(QCPRange range);
+  void xAxisChangeRange(QCPRange range);
 
 private:
-  QList<QStringList> csvlog;
   Ui::LogsDialog *ui;
+  LogTableModel *logModel;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
   bool plotLock;
   QString logFilename;
+  plotsCollection plots;
 
   QVarLengthArray<Qt::GlobalColor> colors;
   QPen pen;
@@ -103,11 +107,13 @@ private:
   QCPItemStraightLine * cursorLine;
 
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QVector<int> selectedLogRows();
+  QVector<int> filterGePoints();
   void exportToGoogleEarth();
   QDateTime getRecordTimeStamp(int index);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
+  void setGraphData(QCPGraph * graph, const coords_t & c, const QCPRange & range);
 
   void addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph);
   void countNumberOfThrows(const coords_t & c, QCPGraph * graph);
@@ -22,10 +22,22 @@
 
 #include <QApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QElapsedTimer>
 #include <QMutexLocker>
+#include <QRunnable>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStorageInfo>
+#include <QThread>
+#include <QUuid>
 
 #define SYNC_MAX_ERRORS       50  // give up after this many errors per destination
+#define SYNC_MAX_THREADS      4   // concurrent file compare/copy jobs, SD cards gain little from more
+#define SYNC_CHUNK_SIZE       (1024 * 1024)  // read/write buffer per job [bytes]
+#define SYNC_MANIFEST_VERSION 1
+#define SYNC_MANIFEST_SETTLE  2000  // don't trust hashes of files modified more recently than this, FAT mtime has 2s resolution [ms]
+#define SYNC_ID_FILE          ".edgetx_sync_id"  // per-volume identity marker, survives drive letter/mount point changes
 
 // a flood of log messages can make the UI unresponsive so we'll introduce a dynamic sleep period based on log frequency (values in [us])
 #define PAUSE_FACTOR          60UL
@@ -52,12 +64,145 @@
   #define FILTER_RE_SYNTX     QRegExp::WildcardUnix
 #endif
 
+SyncManifest::SyncManifest(const QString & root) :
+  m_changed(false)
+{
+  const QByteArray key = QCryptographicHash::hash(identity(root).toUtf8(), QCryptographicHash::Sha1).toHex();
+  m_fileName = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/sync/" + QString::fromLatin1(key) + ".manifest";
+}
+
+// Identifies the folder by a marker file in the root of its volume plus the path below it, so the same card
+// mounted elsewhere keeps its manifest and a different card mounted at the same place doesn't inherit it.
+// Falls back to the absolute path if the volume can't be identified or the marker can't be written.
+QString SyncManifest::identity(const QString & root)
+{
+  const QString absPath = QDir(root).absolutePath();
+  const QStorageInfo storage(absPath);
+  if (!storage.isValid() || !storage.isReady())
+    return absPath;
+
+  const QDir volumeRoot(storage.rootPath());
+  QFile idFile(volumeRoot.filePath(SYNC_ID_FILE));
+  QString id;
+  if (idFile.open(QFile::ReadOnly)) {
+    id = QString::fromLatin1(idFile.readLine(64)).trimmed();
+    idFile.close();
+  }
+  if (QUuid(id).isNull()) {
+    id = QUuid::createUuid().toString();
+    if (storage.isReadOnly() || !idFile.open(QFile::WriteOnly | QFile::Truncate) || idFile.write(id.toLatin1()) < 0)
+      return absPath;
+    idFile.close();
+  }
+  return id + "/" + volumeRoot.relativeFilePath(absPath);
+}
+
+bool SyncManifest::isSettled(const QFileInfo & fileInfo)
+{
+  return fileInfo.lastModified().msecsTo(QDateTime::currentDateTime()) >= SYNC_MANIFEST_SETTLE;
+}
+
+bool SyncManifest::lookup(const QString & relPath, const QFileInfo & fileInfo, QByteArray & hash) const
+{
+  // a file written within the mtime resolution may change again without its size or mtime changing
+  if (!isSettled(fileInfo))
+    return false;
+
+  QMutexLocker locker(&m_mutex);
+  QHash<QString, Entry>::const_iterator it = m_entries.constFind(relPath);
+  if (it == m_entries.constEnd() || it->size != fileInfo.size() || it->modified != fileInfo.lastModified().toMSecsSinceEpoch())
+    return false;
+  hash = it->hash;
+  return true;
+}
+
+void SyncManifest::update(const QString & relPath, const QFileInfo & fileInfo, const QByteArray & hash)
+{
+  if (!isSettled(fileInfo))
+    return;
+
+  QMutexLocker locker(&m_mutex);
+  m_entries.insert(relPath, Entry{fileInfo.size(), fileInfo.lastModified().toMSecsSinceEpoch(), hash});
+  m_changed = true;
+}
+
+void SyncManifest::load()
+{
+  QFile file(m_fileName);
+  if (!file.open(QFile::ReadOnly))
+    return;
+
+  QDataStream in(&file);
+  quint32 version, count;
+  in >> version >> count;
+  if (in.status() != QDataStream::Ok || version != SYNC_MANIFEST_VERSION)
+    return;
+
+  QMutexLocker locker(&m_mutex);
+  while (count--) {
+    QString relPath;
+    Entry entry;
+    in >> relPath >> entry.size >> entry.modified >> entry.hash;
+    if (in.status() != QDataStream::Ok)
+      break;
+    m_entries.insert(relPath, entry);
+  }
+}
+
+void SyncManifest::save()
+{
+  QMutexLocker locker(&m_mutex);
+  if (!m_changed)
+    return;
+
+  QDir().mkpath(QFileInfo(m_fileName).absolutePath());
+  QSaveFile file(m_fileName);
+  if (!file.open(QFile::WriteOnly)) {
+    qWarning() << "Could not write sync manifest" << m_fileName << file.errorString();
+    return;
+  }
+
+  QDataStream out(&file);
+  out << quint32(SYNC_MANIFEST_VERSION) << quint32(m_entries.size());
+  for (QHash<QString, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it)
+    out << it.key() << it->size << it->modified << it->hash;
+  if (file.commit())
+    m_changed = false;
+}
+
+class SyncFileRunnable : public QRunnable
+{
+  public:
+    SyncFileRunnable(SyncProcess * process, const SyncProcess::FileJob & job) :
+      process(process),
+      job(job)
+    {
+    }
+
+    // also called for jobs discarded by QThreadPool::clear()
+    ~SyncFileRunnable() override
+    {
+      process->m_pendingJobs.deref();
+    }
+
+    void run() override
+    {
+      process->processFile(job);
+    }
+
+  protected:
+    SyncProcess * process;
+    SyncProcess::FileJob job;
+};
+
 SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
   m_options(options),
+  m_pendingJobs(0),
   m_pauseTime(PAUSE_MINTM),
   stopping(false)
 {
   qRegisterMetaType<SyncProcess::SyncStatus>();
+  m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), SYNC_MAX_THREADS));
 
   if (m_options.compareType == OVERWR_ALWAYS && (m_options.direction == SYNC_A2B_B2A || m_options.direction == SYNC_B2A_A2B))
     m_options.compareType = OVERWR_IF_DIFF;
@@ -85,6 +230,8 @@ SyncProcess::SyncProcess(const SyncProcess::SyncOptions & options) :
 
 SyncProcess::~SyncProcess()
 {
+  m_pool.clear();
+  m_pool.waitForDone();
 #ifdef Q_OS_WIN
   qt_ntfs_permission_lookup--;  // global revert NTFS permissions checking
 #endif
@@ -109,6 +256,8 @@ void SyncProcess::run()
   const SyncDirection direction = (m_options.direction == SYNC_B2A_A2B ? SYNC_A2B_B2A : SyncDirection(m_options.direction));
   const QString gathering = tr("Gathering file information for %1...");
   const QString noFiles = tr("No files found in %1");
+  SyncManifest manifestA(folderA), manifestB(folderB);
+  QFileInfoList entries;
   int count = 0;
 
   m_stat.clear();
@@ -118,9 +267,12 @@ void SyncProcess::run()
   emit fileCountChanged(0);
   emit statusUpdate(m_stat);
 
+  manifestA.load();
+  manifestB.load();
+
   if (direction == SYNC_A2B_B2A || direction == SYNC_A2B) {
     emit statusMessage(gathering.arg(folderA));
-    count = getFilesCount(folderA);
+    entries = collectEntries(folderA, count);
 
     if (isStopRequsted())
       goto endrun;
@@ -130,7 +282,7 @@ void SyncProcess::run()
       if (m_options.direction == SYNC_A2B_B2A)
         count *= 2;  // assume this direction is only 50% of total, exact will be calculated later
       emit fileCountChanged(count);
-      updateDir(folderA, folderB);
+      updateDir(folderA, folderB, entries, manifestA, manifestB);
       if (isStopRequsted())
         goto endrun;
     }
@@ -142,7 +294,7 @@ void SyncProcess::run()
 
   if (direction == SYNC_A2B_B2A || direction == SYNC_B2A) {
     emit statusMessage(gathering.arg(folderB));
-    count = getFilesCount(folderB);
+    entries = collectEntries(folderB, count);
 
     if (isStopRequsted())
       goto endrun;
@@ -151,7 +303,7 @@ void SyncProcess::run()
     emit fileCountChanged(m_stat.count);
 
     if (count) {
-      updateDir(folderB, folderA);
+      updateDir(folderB, folderA, entries, manifestB, manifestA);
     }
     else {
       PRINT_INFO(noFiles.arg(folderB));
@@ -166,6 +318,8 @@ void SyncProcess::run()
   }
 
   endrun:
+  manifestA.save();
+  manifestB.save();
   finish();
 }
 
@@ -188,6 +342,9 @@ SyncProcess::FileFilterResult SyncProcess::fileFilter(const QFileInfo & fileInfo
   if ((chkDirLnk || ((m_dirFilters & QDir::NoSymLinks) && fileInfo.isFile())) && QFileInfo(fileInfo.absoluteFilePath()).isSymLink())  // MUST create a new QFileInfo here (QTBUG-69001)
     return FILE_LINK_IGNORE;
 
+  if (fileInfo.isFile() && fileInfo.fileName() == SYNC_ID_FILE)
+    return FILE_EXCLUDE;
+
   if (m_options.maxFileSize > 0 && fileInfo.isFile() && fileInfo.size() > m_options.maxFileSize)
     return FILE_OVERSIZE;
 
@@ -217,55 +374,26 @@ void SyncProcess::pushDirEntries(const QFileInfo & fileInfo, QMutableListIterato
   }
 }
 
-int SyncProcess::getFilesCount(const QString & directory)
+QFileInfoList SyncProcess::collectEntries(const QString & directory, int & filesCount)
 {
+  QFileInfoList result;
+  FileFilterResult ffr;
+  filesCount = 0;
   if (!QFile::exists(directory))
-    return 0;
+    return result;
 
-  int result = 0;
   QFileInfoList infoList = dirInfoList(directory);
   QMutableListIterator<QFileInfo> it(infoList);
   it.toBack();
-  while (it.hasPrevious() && !isStopRequsted()) {
-    const QFileInfo fi(it.previous());
-    it.remove();
-    if (fileFilter(fi) == FILE_ALLOW) {
-      pushDirEntries(fi, it);
-      if (fi.isFile()) {
-        result++;
-      }
-    }
-    QApplication::processEvents();
-  }
-  return result;
-}
-
-void SyncProcess::updateDir(const QString & source, const QString & destination)
-{
-  SyncStatus pStat = m_stat;
-  const QDir srcDir(source), dstDir(destination);
-  FileFilterResult ffr;
-  emit statusMessage(testRunStr % tr("Synchronizing: %1\n    To: %2").arg(source, destination));
-  PRINT_INFO(testRunStr % tr("Starting synchronization:\n  %1 -> %2\n").arg(source, destination));
-
-  QFileInfoList infoList = dirInfoList(source);
-  QMutableListIterator<QFileInfo> it(infoList);
-  it.toBack();
   while (it.hasPrevious() && !isStopRequsted()) {
     const QFileInfo fi(it.previous());
     it.remove();
     if ((ffr = fileFilter(fi)) == FILE_ALLOW) {
       pushDirEntries(fi, it);
-      if ((m_dirFilters & QDir::Dirs) || fi.isFile()) {
-        updateEntry(fi.filePath(), srcDir, dstDir);
-        if (fi.isFile())
-          ++m_stat.index;
-        emit statusUpdate(m_stat);
-        if (m_stat.errored - pStat.errored > SYNC_MAX_ERRORS) {
-          PRINT_ERROR(tr("\nToo many errors, giving up."));
-          break;
-        }
-      }
+      if ((m_dirFilters & QDir::Dirs) || fi.isFile())
+        result.append(fi);
+      if (fi.isFile())
+        filesCount++;
     }
     else if (m_options.logLevel == QtDebugMsg) {
       switch (ffr) {
@@ -283,23 +411,55 @@ void SyncProcess::updateDir(const QString & source, const QString & destination)
       }
       // don't count as skipped because these weren't included in the total file count to begin with
     }
+    QApplication::processEvents();
+  }
+  return result;
+}
+
+void SyncProcess::updateDir(const QString & source, const QString & destination, const QFileInfoList & entries, SyncManifest & srcManifest, SyncManifest & destManifest)
+{
+  const SyncStatus pStat = status();
+  const QDir srcDir(source), dstDir(destination);
+  emit statusMessage(testRunStr % tr("Synchronizing: %1\n    To: %2").arg(source, destination));
+  PRINT_INFO(testRunStr % tr("Starting synchronization:\n  %1 -> %2\n").arg(source, destination));
+
+  // directories and stat-only decisions are handled here, in order, file contents are compared and copied in the pool
+  for (const QFileInfo & fi : entries) {
+    if (isStopRequsted())
+      break;
+    updateEntry(fi.filePath(), srcDir, dstDir, srcManifest, destManifest);
+    emit statusUpdate(status());
+    if (status().errored - pStat.errored > SYNC_MAX_ERRORS) {
+      PRINT_ERROR(tr("\nToo many errors, giving up."));
+      m_pool.clear();
+      break;
+    }
     // throttle if needed
-    m_pauseTime = qMax(m_pauseTime - PAUSE_RECOVERY, PAUSE_MINTM);
+    {
+      QMutexLocker locker(&m_statMutex);
+      m_pauseTime = qMax(m_pauseTime - PAUSE_RECOVERY, PAUSE_MINTM);
+    }
     pause();
   }
 
+  if (isStopRequsted())
+    m_pool.clear();
+  waitForJobs(0);
+  const SyncStatus stat = status();
+  emit statusUpdate(stat);
+
   QString endStr = "\n" % testRunStr;
   if (isStopRequsted())
     endStr.append(tr("Aborted synchronization of:"));
   else
     endStr.append(tr("Finished synchronizing:"));
   endStr.append(QString("\n  %1 -> %2\n  ").arg(source, destination));
-  endStr.append(tr("Created: %1; Updated: %2; Skipped: %3; Errors: %4;").arg(m_stat.created-pStat.created).arg(m_stat.updated-pStat.updated).arg(m_stat.skipped-pStat.skipped).arg(m_stat.errored-pStat.errored));
+  endStr.append(tr("Created: %1; Updated: %2; Skipped: %3; Errors: %4;").arg(stat.created-pStat.created).arg(stat.updated-pStat.updated).arg(stat.skipped-pStat.skipped).arg(stat.errored-pStat.errored));
   PRINT_INFO(endStr);
   PRINT_SEP();
 }
 
-bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const QDir & destination)
+bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const QDir & destination, SyncManifest & srcManifest, SyncManifest & destManifest)
 {
   const QString srcPath = QDir::toNativeSeparators(source.absoluteFilePath(entry));
   const QString destPath = QDir::toNativeSeparators(destination.absoluteFilePath(source.relativeFilePath(entry)));
@@ -314,7 +474,7 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
       if (mkPath == lastMkPath) {
         // we've already tried, and apparently failed, to create this folder... bail out but log as error.
         if (!(m_options.flags & OPT_DRY_RUN)) {
-          ++m_stat.errored;
+          countResult(&SyncStatus::errored, !sourceInfo.isDir());
           return false;
         }
       }
@@ -323,7 +483,7 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
         PRINT_CREATE(tr("Creating directory: %1").arg(mkPath));
         if (!(m_options.flags & OPT_DRY_RUN) && !destination.mkpath(mkPath)) {
           PRINT_ERROR(tr("Could not create directory: %1").arg(mkPath));
-            ++m_stat.errored;
+          countResult(&SyncStatus::errored, !sourceInfo.isDir());
           return false;
         }
       }
@@ -336,83 +496,175 @@ bool SyncProcess::updateEntry(const QString & entry, const QDir & source, const
   }
 
   //qDebug() << destPath;
-  QFile sourceFile(srcPath);
-  QFile destinationFile(destPath);
   const bool destExists = destInfo.exists();
-  bool checkDate = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_NEWER_ALWAYS);
-  bool checkContent = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_IF_DIFF);
-  bool existed = false;
+  const bool checkDate = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_NEWER_ALWAYS);
+  const bool checkContent = (m_options.compareType == OVERWR_NEWER_IF_DIFF || m_options.compareType == OVERWR_IF_DIFF);
 
   if (destExists && checkDate) {
     const QDate cmprDate = QDate::currentDate();
     if (sourceInfo.lastModified().date() > cmprDate || destInfo.lastModified().date() > cmprDate) {
       PRINT_ERROR(tr("At least one of the file modification dates is in the future, error on: %1").arg(srcPath));
-      ++m_stat.errored;
+      countResult(&SyncStatus::errored, true);
       return false;
     }
     if (sourceInfo.lastModified() <= destInfo.lastModified()) {
       PRINT_SKIP(tr("Skipping older file: %1").arg(srcPath));
-      ++m_stat.skipped;
+      countResult(&SyncStatus::skipped, true);
       return true;
     }
-    checkDate = false;
   }
 
-  if (destExists && checkContent) {
-    if (!sourceFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(srcPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
+  // keep a bounded number of jobs queued so memory use doesn't grow with the tree size
+  waitForJobs(2 * m_pool.maxThreadCount());
+  m_pendingJobs.ref();
+  m_pool.start(new SyncFileRunnable(this, FileJob{srcPath, destPath, source.relativeFilePath(entry), destExists, destExists && checkContent, &srcManifest, &destManifest}));
+  return true;
+}
+
+void SyncProcess::processFile(const FileJob & job)
+{
+  QString error;
+
+  if (isStopRequsted())
+    return;
+
+  if (job.checkContent) {
+    QByteArray srcHash, destHash;
+    if (!fileHash(job.srcPath, job.relPath, job.srcManifest, srcHash, error)) {
+      PRINT_ERROR(tr("Could not open source file '%1': %2").arg(job.srcPath, error));
+      countResult(&SyncStatus::errored, true);
+      return;
     }
-    if (!destinationFile.open(QFile::ReadOnly)) {
-      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-      ++m_stat.errored;
-      return false;
+    if (!fileHash(job.destPath, job.relPath, job.destManifest, destHash, error)) {
+      PRINT_ERROR(tr("Could not open destination file '%1': %2").arg(job.destPath, error));
+      countResult(&SyncStatus::errored, true);
+      return;
     }
-
-    const bool skip = QCryptographicHash::hash(sourceFile.readAll(), QCryptographicHash::Md5) == QCryptographicHash::hash(destinationFile.readAll(), QCryptographicHash::Md5);
-    sourceFile.close();
-    destinationFile.close();
-    if (skip) {
-      PRINT_SKIP(tr("Skipping identical file: %1").arg(srcPath));
-      ++m_stat.skipped;
-      return true;
+    if (srcHash == destHash) {
+      PRINT_SKIP(tr("Skipping identical file: %1").arg(job.srcPath));
+      countResult(&SyncStatus::skipped, true);
+      return;
     }
-    checkContent = false;
   }
 
-  if (!destExists || (!checkDate && !checkContent)) {
-    if (destInfo.exists()) {
-      existed = true;
-      PRINT_REPLACE(tr("Replacing file: %1").arg(destPath));
-      if (!(m_options.flags & OPT_DRY_RUN) && !destinationFile.remove()) {
-        PRINT_ERROR(tr("Could not delete destination file '%1': %2").arg(destPath, destinationFile.errorString()));
-        ++m_stat.errored;
-        return false;
-      }
-    }
-    else {
-      PRINT_CREATE(tr("Creating file: %1").arg(destPath));
+  if (job.destExists) {
+    PRINT_REPLACE(tr("Replacing file: %1").arg(job.destPath));
+    QFile destinationFile(job.destPath);
+    if (!(m_options.flags & OPT_DRY_RUN) && !destinationFile.remove()) {
+      PRINT_ERROR(tr("Could not delete destination file '%1': %2").arg(job.destPath, destinationFile.errorString()));
+      countResult(&SyncStatus::errored, true);
+      return;
     }
-    if (!(m_options.flags & OPT_DRY_RUN) && !sourceFile.copy(destPath)) {
-      PRINT_ERROR(tr("Copy failed: '%1' to '%2': %3").arg(srcPath, destPath, sourceFile.errorString()));
-      ++m_stat.errored;
-      return false;
+  }
+  else {
+    PRINT_CREATE(tr("Creating file: %1").arg(job.destPath));
+  }
+
+  if (!(m_options.flags & OPT_DRY_RUN)) {
+    QByteArray hash;
+    if (!copyFile(job.srcPath, job.destPath, hash, error)) {
+      PRINT_ERROR(tr("Copy failed: '%1' to '%2': %3").arg(job.srcPath, job.destPath, error));
+      countResult(&SyncStatus::errored, true);
+      return;
     }
+    job.srcManifest->update(job.relPath, QFileInfo(job.srcPath), hash);
+    job.destManifest->update(job.relPath, QFileInfo(job.destPath), hash);
+  }
 
-    if (existed)
-      ++m_stat.updated;
-    else
-      ++m_stat.created;
+  countResult(job.destExists ? &SyncStatus::updated : &SyncStatus::created, true);
+}
+
+bool SyncProcess::fileHash(const QString & path, const QString & relPath, SyncManifest * manifest, QByteArray & hash, QString & error)
+{
+  const QFileInfo fileInfo(path);
+  if (manifest->lookup(relPath, fileInfo, hash))
+    return true;
+
+  QFile file(path);
+  if (!file.open(QFile::ReadOnly)) {
+    error = file.errorString();
+    return false;
+  }
+  QCryptographicHash hasher(QCryptographicHash::Md5);
+  if (!hasher.addData(&file)) {  // reads in chunks
+    error = file.errorString();
+    return false;
+  }
+  hash = hasher.result();
+  manifest->update(relPath, fileInfo, hash);
+  return true;
+}
+
+bool SyncProcess::copyFile(const QString & srcPath, const QString & destPath, QByteArray & hash, QString & error)
+{
+  QFile sourceFile(srcPath);
+  QFile destinationFile(destPath);
+  if (!sourceFile.open(QFile::ReadOnly)) {
+    error = sourceFile.errorString();
+    return false;
+  }
+  if (!destinationFile.open(QFile::WriteOnly)) {
+    error = destinationFile.errorString();
+    return false;
   }
 
+  QCryptographicHash hasher(QCryptographicHash::Md5);
+  QByteArray buffer(SYNC_CHUNK_SIZE, Qt::Uninitialized);
+  qint64 len;
+  while ((len = sourceFile.read(buffer.data(), buffer.size())) > 0) {
+    if (destinationFile.write(buffer.constData(), len) != len) {
+      error = destinationFile.errorString();
+      destinationFile.remove();
+      return false;
+    }
+    hasher.addData(buffer.constData(), len);
+  }
+  if (len < 0) {
+    error = sourceFile.errorString();
+    destinationFile.remove();
+    return false;
+  }
+  if (!destinationFile.flush()) {
+    error = destinationFile.errorString();
+    destinationFile.remove();
+    return false;
+  }
+  destinationFile.close();
+  hash = hasher.result();
   return true;
 }
 
+void SyncProcess::countResult(int SyncStatus::* counter, bool fileDone)
+{
+  QMutexLocker locker(&m_statMutex);
+  ++(m_stat.*counter);
+  if (fileDone)
+    ++m_stat.index;
+}
+
+SyncProcess::SyncStatus SyncProcess::status()
+{
+  QMutexLocker locker(&m_statMutex);
+  return m_stat;
+}
+
+void SyncProcess::waitForJobs(int maxPending)
+{
+  while (m_pendingJobs.load() > maxPending) {
+    QApplication::processEvents();  // delivers stop()
+    if (isStopRequsted())
+      m_pool.clear();
+    m_pool.waitForDone(10);
+    emit statusUpdate(status());
+  }
+}
+
 void SyncProcess::pause()
 {
   QElapsedTimer tim;
+  m_statMutex.lock();
   const qint64 exp = m_pauseTime * 1000;
+  m_statMutex.unlock();
   tim.start();
   while (tim.nsecsElapsed() < exp && !isStopRequsted())
     QApplication::processEvents();
@@ -422,6 +674,7 @@ void SyncProcess::emitProgressMessage(const QString & text, int type)
 {
   if (m_options.logLevel == QtDebugMsg || (m_options.logLevel == QtInfoMsg && type > QtDebugMsg) || (type < QtInfoMsg && type >= m_options.logLevel)) {
     emit progressMessage(text, type);
+    QMutexLocker locker(&m_statMutex);
     m_pauseTime = qMin(m_pauseTime + PAUSE_FACTOR, PAUSE_MAXTM);
   }
 }
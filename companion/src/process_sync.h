@@ -22,14 +22,50 @@
 #define PROCESS_SYNC_H
 
 #include <QObject>
+#include <QAtomicInt>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
 #include <QDirIterator>
+#include <QHash>
+#include <QMutex>
 #include <QReadWriteLock>
 #include <QRegExp>
+#include <QThreadPool>
 #include <QVector>
 
+/*
+ * Cache of file contents hashes for one synchronized folder tree, kept in Companion's cache directory and keyed
+ * by the identity of the volume (card) holding the tree, not by its mount path.
+ * An entry is only trusted while the file size and modification time are unchanged, so unchanged files
+ * can be compared without reading them. All methods are thread-safe.
+ */
+class SyncManifest
+{
+  public:
+    explicit SyncManifest(const QString & root);
+
+    bool lookup(const QString & relPath, const QFileInfo & fileInfo, QByteArray & hash) const;
+    void update(const QString & relPath, const QFileInfo & fileInfo, const QByteArray & hash);
+    void load();
+    void save();
+
+  protected:
+    static QString identity(const QString & root);
+    static bool isSettled(const QFileInfo & fileInfo);
+
+    struct Entry {
+      qint64 size;
+      qint64 modified;
+      QByteArray hash;
+    };
+
+    QString m_fileName;
+    QHash<QString, Entry> m_entries;
+    mutable QMutex m_mutex;
+    bool m_changed;
+};
+
 class SyncProcess : public QObject
 {
     Q_OBJECT
@@ -123,19 +159,40 @@ class SyncProcess : public QObject
   protected:
     enum FileFilterResult { FILE_ALLOW, FILE_OVERSIZE, FILE_EXCLUDE, FILE_LINK_IGNORE };
 
+    // file content comparison and copy, run in the thread pool
+    struct FileJob {
+      QString srcPath;
+      QString destPath;
+      QString relPath;
+      bool destExists;
+      bool checkContent;
+      SyncManifest * srcManifest;
+      SyncManifest * destManifest;
+    };
+    friend class SyncFileRunnable;
+
     bool isStopRequsted();
     void finish();
     FileFilterResult fileFilter(const QFileInfo & fileInfo);
     QFileInfoList dirInfoList(const QString & directory);
-    int getFilesCount(const QString & directory);
-    void updateDir(const QString & source, const QString & destination);
+    QFileInfoList collectEntries(const QString & directory, int & filesCount);
+    void updateDir(const QString & source, const QString & destination, const QFileInfoList & entries, SyncManifest & srcManifest, SyncManifest & destManifest);
     void pushDirEntries(const QFileInfo & fi, QMutableListIterator<QFileInfo> &it);
-    bool updateEntry(const QString & entry, const QDir & source, const QDir & destination);
+    bool updateEntry(const QString & entry, const QDir & source, const QDir & destination, SyncManifest & srcManifest, SyncManifest & destManifest);
+    void processFile(const FileJob & job);
+    bool fileHash(const QString & path, const QString & relPath, SyncManifest * manifest, QByteArray & hash, QString & error);
+    bool copyFile(const QString & srcPath, const QString & destPath, QByteArray & hash, QString & error);
+    void countResult(int SyncStatus::* counter, bool fileDone);
+    SyncStatus status();
+    void waitForJobs(int maxPending);
     void pause();
     void emitProgressMessage(const QString &text, int type);
 
     SyncOptions m_options;
     SyncStatus m_stat;
+    QMutex m_statMutex;
+    QThreadPool m_pool;
+    QAtomicInt m_pendingJobs;
     QReadWriteLock stopReqMutex;
     QString testRunStr;
     QVector<QRegExp> m_excludeFilters;
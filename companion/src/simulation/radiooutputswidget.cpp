@@ -36,6 +36,7 @@ const quint16 RadioOutputsWidget::m_savedViewStateVersion = 2;
 RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware * firmware, QWidget *parent) :
   QWidget(parent),
   m_simulator(simulator),
+  m_outputsMonitor(new SimulatorOutputsMonitor(simulator, this)),
   m_firmware(firmware),
   m_radioProfileId(g.sessionId()),
   ui(new Ui::RadioOutputsWidget)
@@ -48,11 +49,11 @@ RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware
   connect(ui->channelsScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->mixersScroll->horizontalScrollBar(), &QScrollBar::setValue);
   connect(ui->mixersScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->channelsScroll->horizontalScrollBar(), &QScrollBar::setValue);
 
-  connect(m_simulator, &SimulatorInterface::channelOutValueChange, this, &RadioOutputsWidget::onChannelOutValueChange);
-  connect(m_simulator, &SimulatorInterface::channelMixValueChange, this, &RadioOutputsWidget::onChannelMixValueChange);
-  connect(m_simulator, &SimulatorInterface::virtualSwValueChange, this, &RadioOutputsWidget::onVirtSwValueChange);
-  connect(m_simulator, &SimulatorInterface::gVarValueChange, this, &RadioOutputsWidget::onGVarValueChange);
-  connect(m_simulator, &SimulatorInterface::phaseChanged, this, &RadioOutputsWidget::onPhaseChanged);
+  connect(m_outputsMonitor, &SimulatorOutputsMonitor::channelOutValueChange, this, &RadioOutputsWidget::onChannelOutValueChange);
+  connect(m_outputsMonitor, &SimulatorOutputsMonitor::channelMixValueChange, this, &RadioOutputsWidget::onChannelMixValueChange);
+  connect(m_outputsMonitor, &SimulatorOutputsMonitor::virtualSwValueChange, this, &RadioOutputsWidget::onVirtSwValueChange);
+  connect(m_outputsMonitor, &SimulatorOutputsMonitor::gVarValueChange, this, &RadioOutputsWidget::onGVarValueChange);
+  connect(m_outputsMonitor, &SimulatorOutputsMonitor::phaseChanged, this, &RadioOutputsWidget::onPhaseChanged);
 }
 
 RadioOutputsWidget::~RadioOutputsWidget()
@@ -80,6 +81,8 @@ void RadioOutputsWidget::start()
   setupChannelsDisplay(true);
   setupGVarsDisplay();
   setupLsDisplay();
+  // the displays were rebuilt, have all values sent again
+  m_outputsMonitor->reset();
 }
 
 //void RadioOutputsWidget::stop()
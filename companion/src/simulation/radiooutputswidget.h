@@ -23,6 +23,7 @@
 
 #include "simulator.h"
 #include "simulatorinterface.h"
+#include "simulatoroutputsmonitor.h"
 
 #include <QTimer>
 #include <QWidget>
@@ -70,6 +71,7 @@ class RadioOutputsWidget : public QWidget
     QWidget * createLogicalSwitch(QWidget * parent, int switchNo);
 
     SimulatorInterface * m_simulator;
+    SimulatorOutputsMonitor * m_outputsMonitor;
     Firmware * m_firmware;
 
     QHash<int, QPair<QLabel *, QSlider *> > m_channelsMap;  // m_channelsMap[chanIndex] = {QLabel*, QSlider*}
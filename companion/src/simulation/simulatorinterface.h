@@ -58,18 +58,6 @@ class SimulatorInterface : public QObject
       INPUT_SRC_ENUM_COUNT
     };
 
-    enum OutputSourceType {
-      OUTPUT_SRC_NONE = 0,
-      OUTPUT_SRC_CHAN_OUT,
-      OUTPUT_SRC_CHAN_MIX,
-      OUTPUT_SRC_TRIM_VALUE,
-      OUTPUT_SRC_TRIM_RANGE,
-      OUTPUT_SRC_VIRTUAL_SW,
-      OUTPUT_SRC_PHASE,
-      OUTPUT_SRC_GVAR,
-      OUTPUT_SRC_ENUM_COUNT
-    };
-
     // only for data not available from Boards or Firmware, eg. compile-time options
     enum Capability {
       CAP_LUA,                // LUA
@@ -115,6 +103,14 @@ class SimulatorInterface : public QObject
       bool vsw[CPN_MAX_LOGICAL_SWITCHES];  // virtual/logic switches
       int8_t phase;
       qint16 trimRange;                  // TRIM_MAX or TRIM_EXTENDED_MAX
+      qint16 chanLimit;                  // channel outputs range, depends on extended limits
+      char phaseName[16];
+      // number of valid entries in the arrays above
+      quint8 chansCount;
+      quint8 vswCount;
+      quint8 trimsCount;
+      quint8 gvarsCount;
+      quint8 phasesCount;
       // bool beep;
     };
 
@@ -127,6 +123,9 @@ class SimulatorInterface : public QObject
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0) = 0;
     virtual uint16_t getSensorRatio(uint16_t id) = 0;
     virtual const int getCapability(Capability cap) = 0;
+    // Copies the outputs snapshot published by the simulator thread. Returns false
+    // if nothing newer than `version` was published, otherwise updates `version`.
+    virtual bool getOutputs(TxOutputs & outputs, quint32 & version) = 0;
 
   public slots:
 
@@ -158,14 +157,6 @@ class SimulatorInterface : public QObject
     void heartbeat(qint32 loops, qint64 timestamp);
     void runtimeError(const QString & error);
     void lcdChange(bool backlightEnable);
-    void phaseChanged(qint8 phase, const QString & name);
-    void channelOutValueChange(quint8 index, qint32 value, qint32 limit);
-    void channelMixValueChange(quint8 index, qint32 value, qint32 limit);
-    void virtualSwValueChange(quint8 index, qint32 value);
-    void trimValueChange(quint8 index, qint32 value);
-    void trimRangeChange(quint8 index, qint32 min, qint16 max);
-    void gVarValueChange(quint8 index, qint32 value);
-    void outputValueChange(int type, quint8 index, qint32 value);
 };
 
 class SimulatorFactory {
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "simulatoroutputsmonitor.h"
+
+SimulatorOutputsMonitor::SimulatorOutputsMonitor(SimulatorInterface * simulator, QObject * parent) :
+  QObject(parent),
+  m_simulator(simulator),
+  m_version(0),
+  m_reset(true)
+{
+  connect(m_simulator, &SimulatorInterface::started, this, &SimulatorOutputsMonitor::reset);
+  connect(&m_timer, &QTimer::timeout, this, &SimulatorOutputsMonitor::poll);
+  m_timer.start(SIMULATOR_OUTPUTS_POLL_PERIOD);
+}
+
+void SimulatorOutputsMonitor::reset()
+{
+  m_reset = true;
+  m_version = 0;
+}
+
+void SimulatorOutputsMonitor::poll()
+{
+  if (!m_simulator->getOutputs(m_outputs, m_version))
+    return;
+
+  const SimulatorInterface::TxOutputs & last = m_lastOutputs;
+  const SimulatorInterface::TxOutputs & cur = m_outputs;
+  quint8 i;
+
+  for (i = 0; i < cur.chansCount; i++) {
+    if (m_reset || last.chans[i] != cur.chans[i] || last.chanLimit != cur.chanLimit)
+      emit channelOutValueChange(i, cur.chans[i], cur.chanLimit);
+    if (m_reset || last.ex_chans[i] != cur.ex_chans[i])
+      emit channelMixValueChange(i, cur.ex_chans[i], 512 * 2 * 2);
+  }
+
+  for (i = 0; i < cur.vswCount; i++) {
+    if (m_reset || last.vsw[i] != cur.vsw[i])
+      emit virtualSwValueChange(i, cur.vsw[i]);
+  }
+
+  for (i = 0; i < cur.trimsCount; i++) {
+    if (m_reset || last.trims[i] != cur.trims[i])
+      emit trimValueChange(i, cur.trims[i]);
+  }
+
+  if (m_reset || last.trimRange != cur.trimRange)
+    emit trimRangeChange(cur.trimsCount, -cur.trimRange, cur.trimRange);
+
+  if (m_reset || last.phase != cur.phase || strcmp(last.phaseName, cur.phaseName))
+    emit phaseChanged(cur.phase, QString(cur.phaseName));
+
+  for (quint8 gv = 0; gv < cur.gvarsCount; gv++) {
+    for (quint8 fm = 0; fm < cur.phasesCount; fm++) {
+      if (m_reset || last.gvars[fm][gv] != cur.gvars[fm][gv])
+        emit gVarValueChange(gv, cur.gvars[fm][gv]);
+    }
+  }
+
+  m_lastOutputs = m_outputs;
+  m_reset = false;
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) OpenTX
+ *
+ * Based on code named
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#ifndef SIMULATOROUTPUTSMONITOR_H
+#define SIMULATOROUTPUTSMONITOR_H
+
+#include "simulatorinterface.h"
+
+#include <QTimer>
+
+#define SIMULATOR_OUTPUTS_POLL_PERIOD    20  // [ms]
+
+/*
+ * SimulatorOutputsMonitor polls the outputs snapshot published by the simulator thread once per UI frame,
+ * compares it with the previous one and emits a signal for each changed value, in the UI thread.
+ * All values are emitted on the first poll, after reset() and when the simulator (re)starts.
+ */
+class SimulatorOutputsMonitor : public QObject
+{
+  Q_OBJECT
+
+  public:
+    explicit SimulatorOutputsMonitor(SimulatorInterface * simulator, QObject * parent = Q_NULLPTR);
+
+    inline const SimulatorInterface::TxOutputs & outputs() const { return m_outputs; }
+
+  public slots:
+    void reset();
+
+  signals:
+    void phaseChanged(qint8 phase, const QString & name);
+    void channelOutValueChange(quint8 index, qint32 value, qint32 limit);
+    void channelMixValueChange(quint8 index, qint32 value, qint32 limit);
+    void virtualSwValueChange(quint8 index, qint32 value);
+    void trimValueChange(quint8 index, qint32 value);
+    void trimRangeChange(quint8 index, qint32 min, qint16 max);
+    void gVarValueChange(quint8 index, qint32 value);
+
+  protected slots:
+    void poll();
+
+  protected:
+    SimulatorInterface * m_simulator;
+    QTimer m_timer;
+    SimulatorInterface::TxOutputs m_outputs;
+    SimulatorInterface::TxOutputs m_lastOutputs;
+    quint32 m_version;
+    bool m_reset;
+};
+
+#endif // SIMULATOROUTPUTSMONITOR_H
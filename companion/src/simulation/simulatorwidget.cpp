@@ -48,6 +48,7 @@ SimulatorWidget::SimulatorWidget(QWidget * parent, SimulatorInterface * simulato
   QWidget(parent),
   ui(new Ui::SimulatorWidget),
   simulator(simulator),
+  outputsMonitor(new SimulatorOutputsMonitor(simulator, this)),
   firmware(getCurrentFirmware()),
   radioSettings(GeneralSettings()),
   m_board(getCurrentBoard()),
@@ -139,10 +140,10 @@ SimulatorWidget::SimulatorWidget(QWidget * parent, SimulatorInterface * simulato
   connect(vJoyRight, &VirtualJoystickWidget::valueChange, this, &SimulatorWidget::onRadioWidgetValueChange);
   connect(this, &SimulatorWidget::stickModeChange, vJoyLeft, &VirtualJoystickWidget::loadDefaultsForMode);
   connect(this, &SimulatorWidget::stickModeChange, vJoyRight, &VirtualJoystickWidget::loadDefaultsForMode);
-  connect(simulator, &SimulatorInterface::trimValueChange, vJoyLeft, &VirtualJoystickWidget::setTrimValue);
-  connect(simulator, &SimulatorInterface::trimValueChange, vJoyRight, &VirtualJoystickWidget::setTrimValue);
-  connect(simulator, &SimulatorInterface::trimRangeChange, vJoyLeft, &VirtualJoystickWidget::setTrimRange);
-  connect(simulator, &SimulatorInterface::trimRangeChange, vJoyRight, &VirtualJoystickWidget::setTrimRange);
+  connect(outputsMonitor, &SimulatorOutputsMonitor::trimValueChange, vJoyLeft, &VirtualJoystickWidget::setTrimValue);
+  connect(outputsMonitor, &SimulatorOutputsMonitor::trimValueChange, vJoyRight, &VirtualJoystickWidget::setTrimValue);
+  connect(outputsMonitor, &SimulatorOutputsMonitor::trimRangeChange, vJoyLeft, &VirtualJoystickWidget::setTrimRange);
+  connect(outputsMonitor, &SimulatorOutputsMonitor::trimRangeChange, vJoyRight, &VirtualJoystickWidget::setTrimRange);
 
   connect(this, &SimulatorWidget::simulatorInit, simulator, &SimulatorInterface::init);
   connect(this, &SimulatorWidget::simulatorStart, simulator, &SimulatorInterface::start);
@@ -154,7 +155,7 @@ SimulatorWidget::SimulatorWidget(QWidget * parent, SimulatorInterface * simulato
   connect(simulator, &SimulatorInterface::started, this, &SimulatorWidget::onSimulatorStarted);
   connect(simulator, &SimulatorInterface::heartbeat, this, &SimulatorWidget::onSimulatorHeartbeat);
   connect(simulator, &SimulatorInterface::runtimeError, this, &SimulatorWidget::onSimulatorError);
-  connect(simulator, &SimulatorInterface::phaseChanged, this, &SimulatorWidget::onPhaseChanged);
+  connect(outputsMonitor, &SimulatorOutputsMonitor::phaseChanged, this, &SimulatorWidget::onPhaseChanged);
 
   m_timer.setInterval(SIMULATOR_INTERFACE_HEARTBEAT_PERIOD * 6);
   connect(&m_timer, &QTimer::timeout, this, &SimulatorWidget::onTimerEvent);
@@ -633,8 +634,8 @@ void SimulatorWidget::setupRadioWidgets()
       c = 0;
     ui->VCGridLayout->addWidget(tw, 0, c++, 1, 1);
 
-    connect(simulator, &SimulatorInterface::trimValueChange, tw, &RadioTrimWidget::setTrimValue);
-    connect(simulator, &SimulatorInterface::trimRangeChange, tw, &RadioTrimWidget::setTrimRangeQual);
+    connect(outputsMonitor, &SimulatorOutputsMonitor::trimValueChange, tw, &RadioTrimWidget::setTrimValue);
+    connect(outputsMonitor, &SimulatorOutputsMonitor::trimRangeChange, tw, &RadioTrimWidget::setTrimRangeQual);
     m_radioWidgets.append(tw);
   }
 
@@ -27,6 +27,7 @@
 #include "radiowidget.h"
 #include "simulator.h"
 #include "simulatorinterface.h"
+#include "simulatoroutputsmonitor.h"
 
 #include <QElapsedTimer>
 #include <QTimer>
@@ -120,6 +121,7 @@ class SimulatorWidget : public QWidget
 
     Ui::SimulatorWidget * ui;
     SimulatorInterface * simulator;
+    SimulatorOutputsMonitor * outputsMonitor;
     Firmware * firmware;
     GeneralSettings radioSettings;
 
@@ -34,6 +34,18 @@ void LcdWidget::setData(unsigned char *buf, int width, int height, int depth)
 
   localBuf = (unsigned char *)malloc(lcdSize);
   memset(localBuf, 0, lcdSize);
+
+  // 16 and 12 bits framebuffers have the layout of these formats,
+  // rows are copied as is
+  if (depth == 16)
+    lcdImage = QImage(width, height, QImage::Format_RGB16);
+  else if (depth == 12)
+    lcdImage = QImage(width, height, QImage::Format_RGB444);
+  else
+    lcdImage = QImage(width, height, QImage::Format_RGB32);
+
+  imageBgColor = 0;
+  dirtyRows.fill(true, height);
 }
 
 void LcdWidget::setBgDefaultColor(const QColor &color)
@@ -65,11 +77,35 @@ void LcdWidget::makeScreenshot(const QString &fileName)
   }
 }
 
+void LcdWidget::markRowsDirty(int first, int count)
+{
+  for (int y = first; y < first + count && y < lcdHeight; y++) {
+    dirtyRows[y] = true;
+  }
+}
+
 void LcdWidget::onLcdChanged(bool light)
 {
   QMutexLocker locker(&lcdMtx);
   lightEnable = light;
-  memcpy(localBuf, lcdBuf, lcdSize);
+
+  // a framebuffer row holds 1 pixel row on colour screens, 8 on mono and
+  // 2 on 4 bits screens (pixels are packed vertically)
+  int rowPixels = (lcdDepth >= 8 ? 1 : 8 / lcdDepth);
+  int rowSize = (lcdDepth >= 8 ? lcdWidth * ((lcdDepth + 7) / 8) : lcdWidth);
+
+  for (int offset = 0, y = 0; offset < lcdSize; offset += rowSize, y += rowPixels) {
+    if (memcmp(localBuf + offset, lcdBuf + offset, rowSize)) {
+      memcpy(localBuf + offset, lcdBuf + offset, rowSize);
+      markRowsDirty(y, rowPixels);
+    }
+  }
+
+  // rows still pending from a throttled update are drawn on the next call
+  if (!dirtyRows.contains(true) &&
+      (lcdDepth >= 12 || imageBgColor == (lightEnable ? bgColor : bgDefaultColor).rgb()))
+    return;
+
   if (!redrawTimer.isValid() ||
       redrawTimer.hasExpired(LCD_WIDGET_REFRESH_PERIOD)) {
     update();
@@ -77,80 +113,63 @@ void LcdWidget::onLcdChanged(bool light)
   }
 }
 
-void LcdWidget::doPaint(QPainter &p)
+void LcdWidget::updateImage()
 {
-  QRgb rgb;
-  uint16_t z;
-
-  if (!localBuf) return;
+  QMutexLocker locker(&lcdMtx);
 
-  if (lcdDepth == 16) {
-    for (int x = 0; x < lcdWidth; x++) {
-      for (int y = 0; y < lcdHeight; y++) {
-        z = ((uint16_t *)localBuf)[y * lcdWidth + x];
-        rgb = qRgb(255 * ((z & 0xF800) >> 11) / 0x1F,
-                   255 * ((z & 0x07E0) >> 5) / 0x3F, 255 * (z & 0x001F) / 0x1F);
-        p.setPen(rgb);
-        p.drawPoint(x, y);
-      }
-    }
-    return;
-  }
-  if (lcdDepth == 12) {
-    for (int x = 0; x < lcdWidth; x++) {
-      for (int y = 0; y < lcdHeight; y++) {
-        z = ((uint16_t *)localBuf)[y * lcdWidth + x];
-        rgb = qRgb(255 * ((z & 0xF00) >> 8) / 0x0F,
-                   255 * ((z & 0x0F0) >> 4) / 0x0F, 255 * (z & 0x00F) / 0x0F);
-        p.setPen(rgb);
-        p.drawPoint(x, y);
+  if (lcdDepth < 12) {
+    QColor bg = lightEnable ? bgColor : bgDefaultColor;
+    if (bg.rgb() != imageBgColor) {
+      imageBgColor = bg.rgb();
+      for (int z = 0; z < 16; z++) {
+        palette[z] = qRgb(bg.red() - (z * bg.red()) / 15,
+                          bg.green() - (z * bg.green()) / 15,
+                          bg.blue() - (z * bg.blue()) / 15);
       }
+      dirtyRows.fill(true);
     }
-    return;
   }
 
-  QColor bg;
-  if (lightEnable)
-    bg = bgColor;
-  else
-    bg = bgDefaultColor;
-
-  p.setBackground(QBrush(bg));
-  p.eraseRect(0, 0, 2 * lcdWidth, 2 * lcdHeight);
-
-  if (lcdDepth == 1) {
-    rgb = qRgb(0, 0, 0);
-    p.setPen(rgb);
-    p.setBrush(QBrush(rgb));
-  }
+  for (int y = 0; y < lcdHeight; y++) {
+    if (!dirtyRows[y])
+      continue;
+    dirtyRows[y] = false;
 
-  uint16_t idx, mask;
-  uint16_t previousDepth = 0xFF;
+    if (lcdDepth >= 12) {
+      memcpy(lcdImage.scanLine(y), localBuf + y * lcdWidth * 2, lcdWidth * 2);
+      continue;
+    }
 
-  for (int y = 0; y < lcdHeight; y++) {
-    idx = (y * lcdDepth / 8) * lcdWidth;
-    mask = (1 << (y % 8));
-    for (int x = 0; x < lcdWidth; x++, idx++) {
-      if (lcdDepth == 1) {
-        if (localBuf[idx] & mask) p.drawRect(2 * x, 2 * y, 1, 1);
-        continue;
+    QRgb *line = (QRgb *)lcdImage.scanLine(y);
+    const unsigned char *src = localBuf + (y * lcdDepth / 8) * lcdWidth;
+    if (lcdDepth == 1) {
+      uint8_t mask = (1 << (y % 8));
+      for (int x = 0; x < lcdWidth; x++) {
+        line[x] = (src[x] & mask) ? palette[15] : palette[0];
       }
+    }
+    else {
       // lcdDepth == 4
-      z = (y & 1) ? (localBuf[idx] >> 4) : (localBuf[idx] & 0x0F);
-      if (!z) continue;
-      if (z != previousDepth) {
-        previousDepth = z;
-        rgb = qRgb(bg.red() - (z * bg.red()) / 15,
-                   bg.green() - (z * bg.green()) / 15,
-                   bg.blue() - (z * bg.blue()) / 15);
-        p.setPen(rgb);
-        p.setBrush(QBrush(rgb));
+      int shift = (y & 1) ? 4 : 0;
+      for (int x = 0; x < lcdWidth; x++) {
+        line[x] = palette[(src[x] >> shift) & 0x0F];
       }
-      p.drawRect(2 * x, 2 * y, 1, 1);
     }
   }
 }
 
+void LcdWidget::doPaint(QPainter &p)
+{
+  if (!localBuf) return;
+
+  updateImage();
+
+  if (lcdDepth >= 12)
+    p.drawImage(0, 0, lcdImage);
+  else
+    p.drawImage(QRect(0, 0, 2 * lcdWidth, 2 * lcdHeight), lcdImage);
+}
+
 void LcdWidget::paintEvent(QPaintEvent *)
 {
   QPainter p(this);
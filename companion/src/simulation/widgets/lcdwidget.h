@@ -26,6 +26,8 @@
 #include <QClipboard>
 #include <QDir>
 #include <QElapsedTimer>
+#include <QImage>
+#include <QVector>
 #include <QMutex>
 #include <QMutexLocker>
 #include <QMouseEvent>
@@ -84,6 +86,14 @@ class LcdWidget : public QWidget
   QMutex lcdMtx;
   QElapsedTimer redrawTimer;
 
+  // framebuffer converted at native resolution, only dirty rows are updated
+  QImage lcdImage;
+  QVector<bool> dirtyRows;
+  QRgb imageBgColor;
+  QRgb palette[16];
+
+  void markRowsDirty(int first, int count);
+  void updateImage();
   void doPaint(QPainter &p);
 
   void paintEvent(QPaintEvent *) override;
@@ -0,0 +1,107 @@
+#include "gtests.h"
+#include "location.h"
+#include "firmwares/eepromimportexport.h"
+#include "storage/storage.h"
+#include "firmwares/opentx/opentxinterface.h"
+
+#include <QDir>
+#include <QFile>
+
+TEST(EepromImportExport, BitStream)
+{
+  QByteArray input = QByteArray::fromHex("0123456789abcdeffedcba9876543210a5");
+  BitReader reader(input);
+  ASSERT_EQ(17u * 8, reader.size());
+
+  EXPECT_EQ(0x1u, reader.read(0, 4));
+  EXPECT_EQ(0x5230u, reader.read(4, 16));
+  EXPECT_EQ(0xefcdab8967452301ull, reader.read(0, 64));
+  EXPECT_EQ(0xeeu, reader.read(60, 8));
+  EXPECT_EQ(0u, reader.read(17 * 8, 8));
+
+  BitReader slice = reader.slice(8, 12);
+  EXPECT_EQ(12u, slice.size());
+  EXPECT_EQ(0x523u, slice.read(0, 16));
+
+  BitWriter writer;
+  for (unsigned int pos = 0, n = 1; pos < reader.size(); pos += n, n = n % 63 + 7) {
+    n = std::min(n, reader.size() - pos);
+    writer.append(reader.read(pos, n), n);
+  }
+  EXPECT_EQ(input, writer.toBytes());
+
+  writer.resize(12);
+  EXPECT_EQ(QByteArray::fromHex("0103"), writer.toBytes());
+  writer.resize(24);
+  EXPECT_EQ(QByteArray::fromHex("010300"), writer.toBytes());
+}
+
+static QByteArray saveRadioData(const RadioData & radioData)
+{
+  EEPROMInterface * eepromInterface = getCurrentEEpromInterface();
+  QByteArray eeprom(Boards::getEEpromSize(eepromInterface->getBoard()), 0);
+  int size = eepromInterface->save((uint8_t *)eeprom.data(), radioData, 0, getCurrentFirmware()->getVariantNumber());
+  eeprom.resize(size);
+  return eeprom;
+}
+
+TEST(EepromImportExport, FixturesRoundTrip)
+{
+  struct {
+    const char * filename;
+    const char * firmware;
+  } fixtures[] = {
+    { "eeprom_23_x7.bin", "opentx-x7" },
+    { "eeprom_23_x9d+.bin", "opentx-x9d+" },
+    { "eeprom_23_xlite.bin", "opentx-xlite" },
+  };
+
+  Firmware * previousFirmware = getCurrentFirmware();
+
+  for (auto & fixture: fixtures) {
+    RadioData loaded;
+    Storage input = Storage(QString(RADIO_TESTS_PATH "/") + fixture.filename);
+    ASSERT_EQ(true, input.load(loaded)) << fixture.filename;
+
+    Firmware::setCurrentVariant(Firmware::getFirmwareForId(fixture.firmware));
+
+    QString path = QDir::temp().filePath(QString("roundtrip_") + fixture.filename);
+    Storage output = Storage(path);
+    ASSERT_EQ(true, output.write(loaded)) << fixture.filename;
+
+    RadioData saved;
+    ASSERT_EQ(true, output.load(saved)) << fixture.filename;
+    QFile::remove(path);
+
+    const GeneralSettings & settings1 = loaded.generalSettings;
+    const GeneralSettings & settings2 = saved.generalSettings;
+    EXPECT_EQ(settings1.speakerVolume, settings2.speakerVolume) << fixture.filename;
+    EXPECT_EQ(settings1.customFn[0].swtch, settings2.customFn[0].swtch) << fixture.filename;
+    EXPECT_EQ(settings1.customFn[0].func, settings2.customFn[0].func) << fixture.filename;
+    EXPECT_STREQ(settings1.switchName[0], settings2.switchName[0]) << fixture.filename;
+    EXPECT_EQ(settings1.switchConfig[0], settings2.switchConfig[0]) << fixture.filename;
+
+    ASSERT_EQ(loaded.models.size(), saved.models.size()) << fixture.filename;
+    for (unsigned int i = 0; i < loaded.models.size(); i++) {
+      const ModelData & model1 = loaded.models[i];
+      const ModelData & model2 = saved.models[i];
+      EXPECT_EQ(model1.isEmpty(), model2.isEmpty()) << fixture.filename << " model " << i;
+      EXPECT_STREQ(model1.name, model2.name) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.timers[0].mode, model2.timers[0].mode) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.timers[0].swtch, model2.timers[0].swtch) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.mixData[0].weight, model2.mixData[0].weight) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.limitData[0].max, model2.limitData[0].max) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.expoData[0].weight, model2.expoData[0].weight) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.flightModeData[0].gvars[0], model2.flightModeData[0].gvars[0]) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.moduleData[0].protocol, model2.moduleData[0].protocol) << fixture.filename << " model " << i;
+      EXPECT_STREQ(model1.inputNames[0], model2.inputNames[0]) << fixture.filename << " model " << i;
+      EXPECT_STREQ(model1.sensorData[0].label, model2.sensorData[0].label) << fixture.filename << " model " << i;
+      EXPECT_EQ(model1.logicalSw[0].val1, model2.logicalSw[0].val1) << fixture.filename << " model " << i;
+    }
+
+    // every other field: both must export to the same bytes
+    EXPECT_EQ(saveRadioData(loaded), saveRadioData(saved)) << fixture.filename;
+  }
+
+  Firmware::setCurrentVariant(previousFirmware);
+}
@@ -773,6 +773,20 @@ int cliMemoryInfo(const char ** argv)
   serialPrint("------------");
   serialPrint("\tTotal   %u", s + w + e);
 #endif
+#if defined(LUA_ARENA_SIZE)
+  LuaArenaStats stats;
+  luaArenaGetStats(stats);
+  serialPrint("\nLua arena:");
+  serialPrint("\tsize    %u bytes", stats.arenaSize);
+  serialPrint("\tpools   %u bytes (%u free)", stats.arenaUsed, stats.poolsFree);
+  serialPrint("\theap    %u bytes", stats.heapUsed);
+  serialPrint("\tblocks  %u", stats.blocks);
+  for (int i = 0; i < luaScriptsCount; i++) {
+    serialPrint("\t%-10.10s %u", luaGetScriptName(i), luaArenaGetUsage(i));
+  }
+  serialPrint("\twidgets    %u", luaArenaGetUsage(LUA_ARENA_OWNER_WIDGETS));
+  serialPrint("\tsystem     %u", luaArenaGetUsage(LUA_ARENA_OWNER_SYSTEM));
+#endif
 #endif
   return 0;
 }
@@ -993,17 +1007,15 @@ int cliSerialPassthrough(const char **argv)
       // loop until cable disconnected
       while (cdcConnected) {
 
-        uint8_t data;
-        if (intmoduleFifo.pop(data)) {
-
-          uint8_t timeout = 10; // 10 ms
-          while(!usbSerialFreeSpace() && (timeout > 0)) {
-            delay_ms(1);
-            timeout--;
-          }
-
-          usbSerialPutc(data);
+        // module bytes go straight into the USB buffer, they wait in
+        // the module fifo while the buffer is full
+        uint32_t size;
+        uint8_t * buffer = usbSerialClaim(&size);
+        uint32_t count = 0;
+        while (count < size && intmoduleFifo.pop(buffer[count])) {
+          count++;
         }
+        usbSerialCommit(count);
 
         // keep us up & running
         WDG_RESET();
@@ -1209,6 +1221,14 @@ int cliDisplay(const char ** argv)
       serialPrint("outputs[%d] = %04d", i, (int)channelOutputs[i]);
     }
   }
+  else if (!strcmp(argv[1], "trainer")) {
+    for (int i=0; i<MAX_TRAINER_CHANNELS; i++) {
+      serialPrint("ppmInput[%d] = %04d", i, (int)ppmInput[i]);
+    }
+    serialPrint("valid = %d", IS_TRAINER_INPUT_VALID());
+    serialPrint("frame age = %dus (max %dus)", trainerFrameAge / 2, trainerFrameAgeMax / 2);
+    trainerFrameAgeMax = 0;
+  }
   else if (!strcmp(argv[1], "rtc")) {
     struct gtm utm;
     gettime(&utm);
@@ -1296,6 +1316,27 @@ int cliDisplay(const char ** argv)
     uint32_t hitRate = diskCache.getHitRate();
     serialPrint("Disk Cache stats: w:%u r: %u, h: %u(%0.1f%%), m: %u", stats.noWrites, (stats.noHits + stats.noMisses), stats.noHits, hitRate*0.1f, stats.noMisses);
   }
+#endif
+#if defined(SDCARD) && !defined(LIBOPENUI)
+  else if (!strcmp(argv[1], "dir")) {
+    const DirectoryCacheStats & stats = dirCache.getStats();
+    serialPrint("Directory Cache stats: h: %u, m: %u", stats.noHits, stats.noMisses);
+  }
+#endif
+#if defined(CROSSFIRE)
+  else if (!strcmp(argv[1], "crsf")) {
+    static const char * const frameTypes[CRSF_TYPE_COUNT] = {
+      "gps", "vario", "batt", "link", "linkrx", "linktx", "att", "fm", "radio", "other"
+    };
+    for (uint8_t module = 0; module < NUM_MODULES; module++) {
+      const CrossfireTelemetryStats & stats = crossfireTelemetryStats[module];
+      serialPrint("CRSF module %d stats: f: %u, crc: %u, malformed: %u, overruns: %u", module, stats.frames, stats.crcErrors, stats.malformed, stats.overruns);
+      for (uint8_t type = 0; type < CRSF_TYPE_COUNT; type++) {
+        if (stats.typeRate[type])
+          serialPrint(" %s: %u/s", frameTypes[type], stats.typeRate[type]);
+      }
+    }
+  }
 #endif
   else if (toLongLongInt(argv, 1, &address) > 0) {
     int size = 256;
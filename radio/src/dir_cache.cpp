@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "opentx.h"
+
+#if !defined(LIBOPENUI)
+
+#if 0     // set to 1 to enable traces
+  #define TRACE_DIR_CACHE(...)   TRACE(__VA_ARGS__)
+#else
+  #define TRACE_DIR_CACHE(...)
+#endif
+
+#define DIR_CACHE_STAMP_INVALID  0xFFFFFFFF
+
+DirectoryCache dirCache;
+
+static int compareNames(const void * a, const void * b)
+{
+  return strcasecmp((const char *)a, (const char *)b);
+}
+
+// The volume mount id is part of the key, so that a listing is dropped
+// when the card is changed or remounted (USB mass storage included).
+// FatFs doesn't update the directory timestamp when a file is created or
+// removed, our own writes have to call DirectoryCache::invalidate()
+static uint32_t getDirectoryStamp()
+{
+  return g_FATFS_Obj.id;
+}
+
+DirectoryListing::DirectoryListing():
+  extension(nullptr),
+  maxlen(0),
+  flags(0),
+  stamp(DIR_CACHE_STAMP_INVALID),
+  entries(0),
+  entrySize(0),
+  names(nullptr)
+{
+  path[0] = '\0';
+}
+
+uint16_t DirectoryListing::lowerBound(const char * name, uint8_t len) const
+{
+  uint16_t first = 0;
+  uint16_t last = entries;
+  while (first < last) {
+    uint16_t middle = first + (last - first) / 2;
+    if (strncasecmp(getName(middle), name, len) < 0)
+      first = middle + 1;
+    else
+      last = middle;
+  }
+  return first;
+}
+
+bool DirectoryListing::matches(const char * path, const char * extension, uint8_t maxlen, uint8_t flags, uint32_t stamp) const
+{
+  return this->stamp == stamp && this->maxlen == maxlen && this->flags == flags &&
+         (this->extension == extension || (this->extension && extension && !strcmp(this->extension, extension))) &&
+         !strcmp(this->path, path);
+}
+
+bool DirectoryListing::load(const char * path, const char * extension, uint8_t maxlen, uint8_t flags, uint32_t stamp)
+{
+  FILINFO fno;
+  DIR dir;
+
+  clear();
+
+  if (f_opendir(&dir, path) != FR_OK) {
+    return false;
+  }
+
+  uint16_t capacity = 0;
+  entrySize = maxlen + 1;
+  if (flags & LIST_SD_FILE_EXT) {
+    // maxlen doesn't count the extension
+    entrySize += LEN_FILE_EXTENSION_MAX;
+  }
+
+  for (;;) {
+    FRESULT res = f_readdir(&dir, &fno);
+    if (res != FR_OK) {
+      clear();
+      break;
+    }
+    if (fno.fname[0] == 0) {
+      // end of dir
+      strcpy(this->path, path);
+      this->extension = extension;
+      this->maxlen = maxlen;
+      this->flags = flags;
+      this->stamp = stamp;
+      break;
+    }
+
+    uint8_t len = sdFilterListedFile(path, fno, extension, maxlen, flags);
+    if (!len) continue;
+    if (len >= entrySize) {
+      len = entrySize - 1;
+    }
+
+    if (entries == capacity) {
+      uint32_t newCapacity = capacity ? 2 * capacity : 32;
+      if (newCapacity * entrySize > DIR_CACHE_MAX_SIZE) {
+        newCapacity = DIR_CACHE_MAX_SIZE / entrySize;
+      }
+      char * newNames = (newCapacity > capacity ? (char *)realloc(names, newCapacity * entrySize) : nullptr);
+      if (!newNames) {
+        TRACE("DirectoryCache: %s too large to be cached", path);
+        clear();
+        break;
+      }
+      names = newNames;
+      capacity = newCapacity;
+    }
+
+    char * name = &names[entries++ * entrySize];
+    memcpy(name, fno.fname, len);
+    name[len] = '\0';
+  }
+
+  f_closedir(&dir);
+
+  if (stamp == DIR_CACHE_STAMP_INVALID || this->stamp != stamp) {
+    return false;
+  }
+
+  qsort(names, entries, entrySize, compareNames);
+  TRACE_DIR_CACHE("DirectoryCache: %s loaded, %d files", path, entries);
+  return true;
+}
+
+void DirectoryListing::clear()
+{
+  free(names);
+  names = nullptr;
+  entries = 0;
+  stamp = DIR_CACHE_STAMP_INVALID;
+  path[0] = '\0';
+}
+
+DirectoryCache::DirectoryCache():
+  stats(),
+  next(0)
+{
+}
+
+const DirectoryListing * DirectoryCache::getListing(const char * path, const char * extension, uint8_t maxlen, uint8_t flags)
+{
+  if (strlen(path) > DIR_CACHE_PATH_LEN) {
+    return nullptr;
+  }
+
+  uint32_t stamp = getDirectoryStamp();
+
+  for (uint8_t i = 0; i < DIR_CACHE_SLOTS; i++) {
+    if (listings[i].matches(path, extension, maxlen, flags, stamp)) {
+      stats.noHits++;
+      return &listings[i];
+    }
+  }
+
+  stats.noMisses++;
+  DirectoryListing * listing = &listings[next];
+  next = (next + 1) % DIR_CACHE_SLOTS;
+  if (listing->load(path, extension, maxlen, flags, stamp)) {
+    return listing;
+  }
+  return nullptr;
+}
+
+void DirectoryCache::invalidate()
+{
+  for (uint8_t i = 0; i < DIR_CACHE_SLOTS; i++) {
+    listings[i].clear();
+  }
+}
+
+#endif // !LIBOPENUI
+
+void dirCacheInvalidate()
+{
+#if !defined(LIBOPENUI)
+  dirCache.invalidate();
+#endif
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _DIR_CACHE_H_
+#define _DIR_CACHE_H_
+
+#include <inttypes.h>
+#include "ff.h"
+
+// Only the B&W file pickers (sdListFiles) read the cache, the colour
+// pickers are libopenui windows which list the directory themselves
+#if !defined(LIBOPENUI)
+
+// tunable parameters
+#define DIR_CACHE_SLOTS            1
+#define DIR_CACHE_MAX_SIZE         (12 * 1024)   // bytes per listing
+
+#define DIR_CACHE_PATH_LEN         31
+
+// Sorted and filtered names of the files found in a directory
+class DirectoryListing
+{
+  public:
+    DirectoryListing();
+
+    uint16_t count() const
+    {
+      return entries;
+    }
+
+    const char * getName(uint16_t index) const
+    {
+      return &names[index * entrySize];
+    }
+
+    // index of the first name not lower than 'name'
+    uint16_t lowerBound(const char * name, uint8_t len) const;
+
+    bool matches(const char * path, const char * extension, uint8_t maxlen, uint8_t flags, uint32_t stamp) const;
+    bool load(const char * path, const char * extension, uint8_t maxlen, uint8_t flags, uint32_t stamp);
+    void clear();
+
+  protected:
+    char path[DIR_CACHE_PATH_LEN + 1];
+    const char * extension;
+    uint8_t maxlen;
+    uint8_t flags;
+    uint32_t stamp;
+    uint16_t entries;
+    uint8_t entrySize;
+    char * names;
+};
+
+struct DirectoryCacheStats
+{
+  uint32_t noHits;
+  uint32_t noMisses;
+};
+
+// Directory listings shared by the file pickers, so that paging
+// through a large directory doesn't rescan it each time
+class DirectoryCache
+{
+  public:
+    DirectoryCache();
+
+    // 'extension' must be a string constant (the pointer is kept)
+    // returns nullptr if the directory can't be listed or is too large to be cached
+    const DirectoryListing * getListing(const char * path, const char * extension, uint8_t maxlen, uint8_t flags);
+
+    // to be called each time a file is created, renamed or removed,
+    // frees all listings
+    void invalidate();
+
+    const DirectoryCacheStats & getStats() const
+    {
+      return stats;
+    }
+
+  private:
+    DirectoryCacheStats stats;
+    uint8_t next;
+    DirectoryListing listings[DIR_CACHE_SLOTS];
+};
+
+extern DirectoryCache dirCache;
+
+#endif // !LIBOPENUI
+
+// to be called each time a file is created, renamed or removed on the SD card
+// (does nothing on radios without the cache)
+extern "C" void dirCacheInvalidate();
+
+#endif // _DIR_CACHE_H_
@@ -38,7 +38,6 @@
  */
 
 #include "opentx.h"
-#include <ctype.h>
 
 gpsdata_t gpsData;
 
@@ -55,76 +54,130 @@ gpsdata_t gpsData;
      // added by Mis
      - GPS altitude (for OSD displaying)
      - GPS speed (for OSD displaying)
+
+   u-blox receivers are switched to the binary UBX NAV-PVT message, which
+   holds all of the above at fixed offsets, and NAV-DOP for the HDOP. NMEA stays the fallback for the
+   other receivers, and until the u-blox receiver answers
 */
 
 #define NO_FRAME   0
 #define FRAME_GGA  1
 #define FRAME_RMC  2
 
-#define DIGIT_TO_VAL(_x)    (_x - '0')
+#define NMEA_FRACTION_DIGITS    4
+
+#if GPS_USART_BAUDRATE >= 38400
+  #define GPS_UBX_PERIOD_MS     100   // 10Hz
+#else
+  #define GPS_UBX_PERIOD_MS     200   // NAV-PVT is 100 bytes, 5Hz fits in 9600 bauds
+#endif
+#define GPS_UBX_TIMEOUT_MS      2000  // back to NMEA when NAV-PVT stops
+#define GPS_UBX_CONFIG_PERIOD   5000  // ms between configuration attempts
+#define GPS_UBX_CONFIG_RETRIES  3
 
-uint32_t GPS_coord_to_degrees(const char * coordinateString)
+static void gpsPositionReceived()
 {
-  const char * fieldSeparator, * remainingString;
-  uint8_t degrees = 0, minutes = 0;
-  uint16_t fractionalMinutes = 0;
-  uint8_t digitIndex;
-
-  // scan for decimal point or end of field
-  for (fieldSeparator = coordinateString; isdigit((unsigned char) *fieldSeparator); fieldSeparator++) {
-    if (fieldSeparator >= coordinateString + 15)
-      return 0; // stop potential fail
+  uint32_t now = RTOS_GET_MS();
+  if (gpsData.fixTime) {
+    gpsData.updatePeriod = min<uint32_t>(now - gpsData.fixTime, UINT16_MAX);
   }
-  remainingString = coordinateString;
+  gpsData.fixTime = now;
+}
 
-  // convert degrees
-  while ((fieldSeparator - remainingString) > 2) {
-    if (degrees)
-      degrees *= 10;
-    degrees += DIGIT_TO_VAL(*remainingString++);
-  }
-  // convert minutes
-  while (fieldSeparator > remainingString) {
-    if (minutes)
-      minutes *= 10;
-    minutes += DIGIT_TO_VAL(*remainingString++);
+uint32_t gpsGetFixAge()
+{
+  return gpsData.fixTime ? RTOS_GET_MS() - gpsData.fixTime : UINT32_MAX;
+}
+
+// NMEA fields used, in the order of the frames
+enum NmeaField {
+  NMEA_SKIP,
+  NMEA_LATITUDE,
+  NMEA_NORTH_SOUTH,
+  NMEA_LONGITUDE,
+  NMEA_EAST_WEST,
+  NMEA_FIX_QUALITY,
+  NMEA_NUMSAT,
+  NMEA_HDOP,
+  NMEA_ALTITUDE,
+  NMEA_TIME,
+  NMEA_STATUS,
+  NMEA_SPEED,
+  NMEA_COURSE,
+  NMEA_DATE,
+};
+
+static const uint8_t nmeaGGAFields[] = {
+  NMEA_SKIP, NMEA_SKIP, NMEA_LATITUDE, NMEA_NORTH_SOUTH, NMEA_LONGITUDE,
+  NMEA_EAST_WEST, NMEA_FIX_QUALITY, NMEA_NUMSAT, NMEA_HDOP, NMEA_ALTITUDE
+};
+
+static const uint8_t nmeaRMCFields[] = {
+  NMEA_SKIP, NMEA_TIME, NMEA_STATUS, NMEA_SKIP, NMEA_SKIP,
+  NMEA_SKIP, NMEA_SKIP, NMEA_SPEED, NMEA_COURSE, NMEA_DATE
+};
+
+// Numeric value of the current field, accumulated while it is received
+struct NmeaNumber
+{
+  uint32_t integer;
+  uint32_t fraction;
+  uint8_t fractionDigits;
+  bool decimal;
+
+  void reset()
+  {
+    integer = 0;
+    fraction = 0;
+    fractionDigits = 0;
+    decimal = false;
   }
-  // convert fractional minutes
-  // expect up to four digits, result is in
-  // ten-thousandths of a minute
-  if (*fieldSeparator == '.') {
-    remainingString = fieldSeparator + 1;
-    for (digitIndex = 0; digitIndex < 4; digitIndex++) {
-      fractionalMinutes *= 10;
-      if (isdigit((unsigned char) *remainingString))
-        fractionalMinutes += *remainingString++ - '0';
+
+  void push(char c)
+  {
+    if (c >= '0' && c <= '9') {
+      if (!decimal) {
+        if (integer < 100000000)
+          integer = integer * 10 + (c - '0');
+      }
+      else if (fractionDigits < NMEA_FRACTION_DIGITS) {
+        fraction = fraction * 10 + (c - '0');
+        fractionDigits++;
+      }
+    }
+    else if (c == '.') {
+      decimal = true;
     }
   }
-  // TODO return degrees * 10000000UL + (minutes * 1000000UL + fractionalMinutes * 100UL) / 6;
-  return degrees * 1000000UL + (minutes * 100000UL + fractionalMinutes * 10UL) / 6;
-}
 
-// helper functions
-uint32_t grab_fields(char * src, uint8_t mult)
-{
-  uint32_t i;
-  uint32_t tmp = 0;
-  for (i = 0; src[i] != 0; i++) {
-    if (src[i] == '.') {
-      i++;
-      if (mult == 0)
-        break;
-      else
-        src[i + mult] = 0;
+  // value with the given number of decimals (truncated)
+  uint32_t value(uint8_t decimals) const
+  {
+    uint32_t result = integer;
+    uint32_t digits = fraction;
+    uint8_t count = fractionDigits;
+    for (uint8_t i = 0; i < decimals; i++) {
+      result *= 10;
+    }
+    for (; count > decimals; count--) {
+      digits /= 10;
     }
-    tmp *= 10;
-    if (src[i] >= '0' && src[i] <= '9')
-      tmp += src[i] - '0';
-    if (i >= 15)
-      return 0; // out of bounds
+    for (; count < decimals; count++) {
+      digits *= 10;
+    }
+    return result + digits;
   }
-  return tmp;
-}
+
+  // ddmm.mmmm to degrees * 1.000.000
+  uint32_t coordinate() const
+  {
+    uint32_t degrees = integer / 100;
+    uint32_t minutes = integer % 100;
+    // ten-thousandths of a minute
+    uint32_t fractionalMinutes = value(NMEA_FRACTION_DIGITS) - integer * 10000;
+    return degrees * 1000000UL + (minutes * 100000UL + fractionalMinutes * 10UL) / 6;
+  }
+};
 
 typedef struct gpsDataNmea_s
 {
@@ -140,6 +193,17 @@ typedef struct gpsDataNmea_s
   uint32_t time;
 } gpsDataNmea_t;
 
+static bool gpsConfigureUBX();
+
+// NMEA frame, checksum and CRLF added, only if it fits in the TX fifo
+static bool gpsSendFrameIfRoom(const char * frame)
+{
+  if (!gpsTxHasSpace(strlen(frame) + 5))
+    return false;
+  gpsSendFrame(frame);
+  return true;
+}
+
 bool gpsNewFrameNMEA(char c)
 {
   static gpsDataNmea_t gps_Msg;
@@ -147,6 +211,7 @@ bool gpsNewFrameNMEA(char c)
   uint8_t frameOK = 0;
   static uint8_t param = 0, offset = 0, parity = 0;
   static char string[15];
+  static NmeaNumber number;
   static uint8_t checksum_param, gps_frame = NO_FRAME;
 
   switch (c) {
@@ -154,6 +219,7 @@ bool gpsNewFrameNMEA(char c)
       param = 0;
       offset = 0;
       parity = 0;
+      number.reset();
       break;
     case ',':
     case '*':
@@ -167,85 +233,78 @@ bool gpsNewFrameNMEA(char c)
         else if (string[0] == 'G' && string[2] == 'R' && string[3] == 'M' && string[4] == 'C') {
           gps_frame = FRAME_RMC;
         }
-        else {
+        if (gpsData.protocol == GPS_PROTOCOL_UBX) {
+          // positions come from NAV-PVT
+          gps_frame = NO_FRAME;
+        }
+        if (gps_frame == NO_FRAME) {
           // turn off this frame (do this only once a second)
           static gtime_t lastGpsCmdSent = 0;
           if (string[0] == 'G' && g_rtcTime != lastGpsCmdSent) {
-            lastGpsCmdSent = g_rtcTime;
             char cmd[] = "$PUBX,40,GSV,0,0,0,0";
             cmd[9]  = string[2];
             cmd[10] = string[3];
             cmd[11] = string[4];
-            gpsSendFrame(cmd);
+            if (gpsSendFrameIfRoom(cmd))
+              lastGpsCmdSent = g_rtcTime;
           }
         }
       }
+      else {
+        uint8_t field = NMEA_SKIP;
+        if (gps_frame == FRAME_GGA && param < DIM(nmeaGGAFields))
+          field = nmeaGGAFields[param];
+        else if (gps_frame == FRAME_RMC && param < DIM(nmeaRMCFields))
+          field = nmeaRMCFields[param];
 
-      switch (gps_frame) {
-        case FRAME_GGA:        //************* GPGGA FRAME parsing
-          switch (param) {
-            case 2:
-              gps_Msg.latitude = GPS_coord_to_degrees(string);
-              break;
-            case 3:
-              if (string[0] == 'S')
-                gps_Msg.latitude *= -1;
-              break;
-            case 4:
-              gps_Msg.longitude = GPS_coord_to_degrees(string);
-              break;
-            case 5:
-              if (string[0] == 'W')
-                gps_Msg.longitude *= -1;
-              break;
-            case 6:
-              if (string[0] > '0') {
-                gps_Msg.fix = 1;
-              }
-              else {
-                gps_Msg.fix = 0;
-              }
-              break;
-            case 7:
-              gps_Msg.numSat = grab_fields(string, 0);
-              break;
-            case 8:
-              gps_Msg.hdop = grab_fields(string, 1) * 10;
-              break;
-            case 9:
-              gps_Msg.altitude = grab_fields(string, 0);     // altitude in meters added by Mis
-              break;
-          }
-          break;
-        case FRAME_RMC:        //************* GPRMC FRAME parsing
-          switch (param) {
-            case 1:
-              gps_Msg.time = grab_fields(string, 0);
-              break;
-            case 2:
-              if (string[0] == 'A') {
-                gps_Msg.fix = 1;
-              }
-              else {
-                gps_Msg.fix = 0;
-              }
-              break;
-            case 7:
-              gps_Msg.speed = ((grab_fields(string, 1) * 5144L) / 1000L);    // speed in cm/s added by Mis
-              break;
-            case 8:
-              gps_Msg.groundCourse = (grab_fields(string, 1));      // ground course deg * 10
-              break;
-            case 9:
-              gps_Msg.date = grab_fields(string, 0);
-              break;
-          }
-          break;
-
+        switch (field) {
+          case NMEA_LATITUDE:
+            gps_Msg.latitude = number.coordinate();
+            break;
+          case NMEA_NORTH_SOUTH:
+            if (string[0] == 'S')
+              gps_Msg.latitude *= -1;
+            break;
+          case NMEA_LONGITUDE:
+            gps_Msg.longitude = number.coordinate();
+            break;
+          case NMEA_EAST_WEST:
+            if (string[0] == 'W')
+              gps_Msg.longitude *= -1;
+            break;
+          case NMEA_FIX_QUALITY:
+            gps_Msg.fix = (string[0] > '0');
+            break;
+          case NMEA_NUMSAT:
+            gps_Msg.numSat = number.value(0);
+            break;
+          case NMEA_HDOP:
+            gps_Msg.hdop = number.value(1) * 10;
+            break;
+          case NMEA_ALTITUDE:
+            gps_Msg.altitude = number.value(0);     // altitude in meters added by Mis
+            break;
+          case NMEA_TIME:
+            gps_Msg.time = number.value(0);
+            break;
+          case NMEA_STATUS:
+            gps_Msg.fix = (string[0] == 'A');
+            break;
+          case NMEA_SPEED:
+            gps_Msg.speed = ((number.value(1) * 5144L) / 1000L);    // speed in cm/s added by Mis
+            break;
+          case NMEA_COURSE:
+            gps_Msg.groundCourse = number.value(1);      // ground course deg * 10
+            break;
+          case NMEA_DATE:
+            gps_Msg.date = number.value(0);
+            break;
+        }
       }
 
       param++;
       offset = 0;
+      number.reset();
       if (c == '*')
         checksum_param = 1;
       else
@@ -258,6 +317,7 @@ bool gpsNewFrameNMEA(char c)
                            ((string[1] >= 'A') ? string[1] - 'A' + 10 : string[1] - '0');
         if (checksum == parity) {
           gpsData.packetCount++;
+          gpsConfigureUBX();
           switch (gps_frame) {
             case FRAME_GGA:
               frameOK = 1;
@@ -270,6 +330,7 @@ bool gpsNewFrameNMEA(char c)
                 gpsData.longitude = gps_Msg.longitude;
                 gpsData.altitude = gps_Msg.altitude;
                 __enable_irq();
+                gpsPositionReceived();
               }
               break;
             case FRAME_RMC:
@@ -302,15 +363,241 @@ bool gpsNewFrameNMEA(char c)
     default:
       if (offset < 15)
         string[offset++] = c;
+      number.push(c);
       if (!checksum_param)
         parity ^= c;
   }
   return frameOK;
 }
 
+#define UBX_SYNC1           0xB5
+#define UBX_SYNC2           0x62
+#define UBX_CLASS_NAV       0x01
+#define UBX_CLASS_CFG       0x06
+#define UBX_NAV_DOP         0x04
+#define UBX_NAV_PVT         0x07
+#define UBX_CFG_MSG         0x01
+#define UBX_CFG_RATE        0x08
+#define UBX_NAV_DOP_LENGTH  18
+#define UBX_NAV_PVT_LENGTH  92
+#define UBX_FRAME_LENGTH(payload)  (8 + (payload))
+
+enum UbxState {
+  UBX_STATE_SYNC1,
+  UBX_STATE_SYNC2,
+  UBX_STATE_CLASS,
+  UBX_STATE_ID,
+  UBX_STATE_LENGTH1,
+  UBX_STATE_LENGTH2,
+  UBX_STATE_PAYLOAD,
+  UBX_STATE_CK_A,
+  UBX_STATE_CK_B,
+};
+
+struct UbxParser
+{
+  uint8_t state;
+  uint8_t msgClass;
+  uint8_t msgId;
+  uint16_t length;
+  uint16_t count;
+  uint8_t ckA;
+  uint8_t ckB;
+  uint8_t payload[UBX_NAV_PVT_LENGTH];
+};
+
+static UbxParser ubx;
+static uint32_t ubxLastFrame;
+static uint32_t ubxConfigTime;
+static uint8_t ubxConfigRetries;
+
+// Frames still to be sent after a fallback to NMEA, one per gpsWakeup(),
+// they don't fit all together in the TX fifo
+enum GpsPendingFrames {
+  GPS_PENDING_GGA_ON = (1 << 0),
+  GPS_PENDING_RMC_ON = (1 << 1),
+  GPS_PENDING_UBX_CONFIG = (1 << 2),
+};
+static uint8_t gpsPendingFrames;
+
+static inline uint16_t ubxUint16(const uint8_t * p)
+{
+  return p[0] | (p[1] << 8);
+}
+
+static inline int32_t ubxInt32(const uint8_t * p)
+{
+  return int32_t(p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24));
+}
+
+static void gpsSendUBX(uint8_t msgClass, uint8_t msgId, const uint8_t * payload, uint16_t length)
+{
+  uint8_t header[] = { msgClass, msgId, uint8_t(length), uint8_t(length >> 8) };
+  uint8_t ckA = 0, ckB = 0;
+
+  gpsSendByte(UBX_SYNC1);
+  gpsSendByte(UBX_SYNC2);
+  for (uint8_t byte: header) {
+    ckA += byte;
+    ckB += ckA;
+    gpsSendByte(byte);
+  }
+  for (uint16_t i = 0; i < length; i++) {
+    ckA += payload[i];
+    ckB += ckA;
+    gpsSendByte(payload[i]);
+  }
+  gpsSendByte(ckA);
+  gpsSendByte(ckB);
+}
+
+// Ask an u-blox receiver for NAV-PVT at GPS_UBX_PERIOD_MS, other receivers
+// ignore it and keep sending NMEA. Returns false when the TX fifo is too
+// full, the configuration has to be sent again later
+static bool gpsConfigureUBX()
+{
+  if (gpsData.protocol == GPS_PROTOCOL_UBX || ubxConfigRetries >= GPS_UBX_CONFIG_RETRIES)
+    return true;
+
+  uint32_t now = RTOS_GET_MS();
+  if (ubxConfigRetries > 0 && now - ubxConfigTime < GPS_UBX_CONFIG_PERIOD)
+    return true;
+
+  if (!gpsTxHasSpace(UBX_FRAME_LENGTH(6) + 2 * UBX_FRAME_LENGTH(3)))
+    return false;
+
+  ubxConfigTime = now;
+  ubxConfigRetries++;
+
+  // measurement period, 1 navigation solution per measurement, GPS time
+  const uint8_t rate[] = { GPS_UBX_PERIOD_MS & 0xFF, GPS_UBX_PERIOD_MS >> 8, 1, 0, 1, 0 };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_RATE, rate, sizeof(rate));
+
+  // NAV-PVT and NAV-DOP on every navigation solution, on the current port
+  const uint8_t pvt[] = { UBX_CLASS_NAV, UBX_NAV_PVT, 1 };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, pvt, sizeof(pvt));
+  const uint8_t dop[] = { UBX_CLASS_NAV, UBX_NAV_DOP, 1 };
+  gpsSendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, dop, sizeof(dop));
+  return true;
+}
+
+static void gpsProcessNavPvt(const uint8_t * payload)
+{
+  uint8_t valid = payload[11];
+  uint8_t fixType = payload[20];
+  uint8_t flags = payload[21];
+
+  ubxLastFrame = RTOS_GET_MS();
+  gpsData.protocol = GPS_PROTOCOL_UBX;
+
+  gpsData.fix = (flags & 0x01) && fixType >= 2 && fixType <= 4;
+  gpsData.numSat = payload[23];
+  gpsData.speed = ubxInt32(&payload[60]) / 10;                  // mm/s to cm/s, as NMEA
+  gpsData.groundCourse = ubxInt32(&payload[64]) / 10000;        // 1e-5 degrees to degrees * 10
+
+  if (gpsData.fix) {
+    __disable_irq();    // do the atomic update of lat/lon
+    gpsData.longitude = ubxInt32(&payload[24]) / 10;            // 1e-7 to 1e-6 degrees
+    gpsData.latitude = ubxInt32(&payload[28]) / 10;
+    gpsData.altitude = ubxInt32(&payload[36]) / 1000;           // mm to m, as NMEA
+    __enable_irq();
+    gpsPositionReceived();
+  }
+
+#if defined(RTCLOCK)
+  // set RTC clock if needed
+  if (g_eeGeneral.adjustRTC && gpsData.fix && (valid & 0x03) == 0x03) {
+    rtcAdjust(ubxUint16(&payload[4]), payload[6], payload[7], payload[8], payload[9], payload[10]);
+  }
+#else
+  (void)valid;
+#endif
+}
+
+static void gpsProcessNavDop(const uint8_t * payload)
+{
+  gpsData.hdop = ubxUint16(&payload[12]);                       // 0.01, as NMEA
+}
+
+bool gpsNewFrameUBX(uint8_t c)
+{
+  bool frameOK = false;
+
+  if (ubx.state >= UBX_STATE_CLASS && ubx.state <= UBX_STATE_PAYLOAD) {
+    ubx.ckA += c;
+    ubx.ckB += ubx.ckA;
+  }
+
+  switch (ubx.state) {
+    case UBX_STATE_SYNC1:
+      if (c == UBX_SYNC1)
+        ubx.state = UBX_STATE_SYNC2;
+      break;
+    case UBX_STATE_SYNC2:
+      ubx.state = (c == UBX_SYNC2 ? UBX_STATE_CLASS : UBX_STATE_SYNC1);
+      ubx.ckA = ubx.ckB = 0;
+      break;
+    case UBX_STATE_CLASS:
+      ubx.msgClass = c;
+      ubx.state = UBX_STATE_ID;
+      break;
+    case UBX_STATE_ID:
+      ubx.msgId = c;
+      ubx.state = UBX_STATE_LENGTH1;
+      break;
+    case UBX_STATE_LENGTH1:
+      ubx.length = c;
+      ubx.state = UBX_STATE_LENGTH2;
+      break;
+    case UBX_STATE_LENGTH2:
+      ubx.length |= c << 8;
+      ubx.count = 0;
+      if (ubx.length > sizeof(ubx.payload)) {
+        // none of the messages we ask for is longer, a byte was lost
+        // in the header: don't swallow the following frames
+        gpsData.errorCount++;
+        ubx.state = UBX_STATE_SYNC1;
+        break;
+      }
+      ubx.state = (ubx.length ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A);
+      break;
+    case UBX_STATE_PAYLOAD:
+      ubx.payload[ubx.count] = c;
+      if (++ubx.count == ubx.length)
+        ubx.state = UBX_STATE_CK_A;
+      break;
+    case UBX_STATE_CK_A:
+      ubx.state = (c == ubx.ckA ? UBX_STATE_CK_B : UBX_STATE_SYNC1);
+      if (c != ubx.ckA)
+        gpsData.errorCount++;
+      break;
+    case UBX_STATE_CK_B:
+      ubx.state = UBX_STATE_SYNC1;
+      if (c != ubx.ckB) {
+        gpsData.errorCount++;
+        break;
+      }
+      gpsData.packetCount++;
+      if (ubx.msgClass == UBX_CLASS_NAV && ubx.msgId == UBX_NAV_PVT && ubx.length == UBX_NAV_PVT_LENGTH) {
+        gpsProcessNavPvt(ubx.payload);
+        frameOK = true;
+      }
+      else if (ubx.msgClass == UBX_CLASS_NAV && ubx.msgId == UBX_NAV_DOP && ubx.length == UBX_NAV_DOP_LENGTH) {
+        gpsProcessNavDop(ubx.payload);
+      }
+      break;
+  }
+
+  return frameOK;
+}
+
 bool gpsNewFrame(uint8_t c)
 {
-  return gpsNewFrameNMEA(c);
+  // NMEA is plain ASCII, the UBX sync char can't be part of it
+  if (ubx.state != UBX_STATE_SYNC1 || c == UBX_SYNC1)
+    return gpsNewFrameUBX(c);
+  else
+    return gpsNewFrameNMEA(c);
 }
 
 void gpsNewData(uint8_t c)
@@ -326,6 +613,29 @@ void gpsWakeup()
   while (gpsGetByte(&byte)) {
     gpsNewData(byte);
   }
+
+  if (gpsData.protocol == GPS_PROTOCOL_UBX && RTOS_GET_MS() - ubxLastFrame > GPS_UBX_TIMEOUT_MS) {
+    // receiver restarted with its default configuration, or lost.
+    // GGA and RMC were turned off while in UBX, turn them back on in case
+    // the receiver is still there, and ask again for NAV-PVT
+    gpsData.protocol = GPS_PROTOCOL_NMEA;
+    ubx.state = UBX_STATE_SYNC1;
+    ubxConfigRetries = 0;
+    gpsPendingFrames = GPS_PENDING_GGA_ON | GPS_PENDING_RMC_ON | GPS_PENDING_UBX_CONFIG;
+  }
+
+  if (gpsPendingFrames & GPS_PENDING_GGA_ON) {
+    if (gpsSendFrameIfRoom("$PUBX,40,GGA,0,1,0,0"))
+      gpsPendingFrames &= ~GPS_PENDING_GGA_ON;
+  }
+  else if (gpsPendingFrames & GPS_PENDING_RMC_ON) {
+    if (gpsSendFrameIfRoom("$PUBX,40,RMC,0,1,0,0"))
+      gpsPendingFrames &= ~GPS_PENDING_RMC_ON;
+  }
+  else if (gpsPendingFrames & GPS_PENDING_UBX_CONFIG) {
+    if (gpsConfigureUBX())
+      gpsPendingFrames &= ~GPS_PENDING_UBX_CONFIG;
+  }
 }
 
 char hex(uint8_t b) {
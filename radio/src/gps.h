@@ -35,11 +35,23 @@ struct gpsdata_t
   uint16_t altitude;              // altitude in 0.1m
   uint16_t speed;                 // speed in 0.1m/s
   uint16_t groundCourse;          // degrees * 10
-  uint16_t hdop;
+  uint16_t hdop;                  // 0.01
+  uint8_t protocol;               // GPS_PROTOCOL_NMEA or GPS_PROTOCOL_UBX
+  uint16_t updatePeriod;          // ms between the last two positions
+  uint32_t fixTime;               // RTOS_GET_MS() of the last position, 0 if none
+};
+
+enum GpsProtocol {
+  GPS_PROTOCOL_NMEA,
+  GPS_PROTOCOL_UBX,
 };
 
 extern gpsdata_t gpsData;
 void gpsWakeup();
+bool gpsNewFrame(uint8_t c);
+
+// ms since the last position, UINT32_MAX if none was received
+uint32_t gpsGetFixAge();
 
 void gpsSendFrame(const char * frame);
 
@@ -166,6 +166,8 @@ void menuModelFlightModeOne(event_t event)
           if (checkIncDec_Ret) {
             if (v == GVAR_MAX) v = 0;
             fm->gvars[idx] = v;
+            // checkIncDec() marked the model dirty before the store
+            invalidateGVarCache();
           }
         }
         editGVarValue(17*FW, y, event, idx, getGVarFlightMode(s_currIdx, idx), posHorz==2 ? attr : 0);
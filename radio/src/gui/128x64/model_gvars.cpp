@@ -46,6 +46,10 @@ void editGVarValue(coord_t x, coord_t y, event_t event, uint8_t gvar, uint8_t fl
     }
     else if (s_editMode > 0) {
       *v = checkIncDec(event, *v, vmin, vmax, EE_MODEL);
+      if (checkIncDec_Ret) {
+        // checkIncDec() marked the model dirty before the store
+        invalidateGVarCache();
+      }
     }
   }
 }
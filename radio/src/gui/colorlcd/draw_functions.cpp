@@ -22,6 +22,7 @@
 #include "opentx.h"
 #include "lcd.h"
 #include "theme_manager.h"
+#include "fonts.h"
 
 coord_t drawStringWithIndex(BitmapBuffer * dc, coord_t x, coord_t y, const char * str, int idx, LcdFlags flags, const char * prefix, const char * suffix)
 {
@@ -165,6 +166,8 @@ void drawShutdownAnimation(uint32_t duration, uint32_t totalDuration,
 
 void drawFatalErrorScreen(const char * message)
 {
+  loadFont(FONT_XL_INDEX);
+
   lcd->reset();
   lcd->clear(COLOR2FLAGS(BLACK));
   lcd->drawText(LCD_W/2, LCD_H/2-20, message, FONT(XL)|CENTERED|COLOR2FLAGS(WHITE));
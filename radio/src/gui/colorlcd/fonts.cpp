@@ -20,6 +20,7 @@
  */
 
 #include "opentx.h"
+#include "fonts.h"
 
 const uint16_t font_xxs_specs[] = {
 #include "font_9.specs"
@@ -131,7 +132,7 @@ const unsigned char font_xxl[] = {
 // -2 for: overall length and last boundary
 const uint16_t fontCharactersTable[FONTS_COUNT] = { sizeof(font_std_en_specs)/2-2 };
 const uint16_t * const fontspecsTable[FONTS_COUNT] = { font_std_en_specs };
-const uint8_t * fontsTable[FONTS_COUNT] = { font_std_en };
+static const uint8_t * const fontsCompressedTable[FONTS_COUNT] = { font_std_en };
 const int fontsSizeTable[FONTS_COUNT] = { sizeof(font_std_en) };
 #else
 // -2 for: overall length and last boundary
@@ -144,7 +145,7 @@ const uint16_t *const fontspecsTable[FONTS_COUNT] = {
     font_std_specs, font_bold_specs, font_xxs_specs, font_xs_specs,
     font_l_specs,   font_xl_specs,   font_xxl_specs
 };
-const uint8_t *fontsTable[FONTS_COUNT] = {
+static const uint8_t * const fontsCompressedTable[FONTS_COUNT] = {
     font_std, font_bold, font_xxs, font_xs, font_l, font_xl, font_xxl
 };
 const int fontsSizeTable[FONTS_COUNT] = {
@@ -154,6 +155,9 @@ const int fontsSizeTable[FONTS_COUNT] = {
 };
 #endif
 
+// Decompressed fonts, nullptr until first used
+const uint8_t * fontsTable[FONTS_COUNT] = { nullptr };
+
 uint8_t * decompressFont(const uint8_t * font, unsigned len)
 {
   int width  = 0;
@@ -166,6 +170,10 @@ uint8_t * decompressFont(const uint8_t * font, unsigned len)
 
   size_t font_size = width * height;
   uint8_t * buf = (uint8_t *)malloc(font_size + 4);
+  if (!buf) {
+    free(raw_font);
+    return nullptr;
+  }
 
   ((uint16_t*)buf)[0] = (uint16_t)width;
   ((uint16_t*)buf)[1] = (uint16_t)height;
@@ -181,23 +189,38 @@ uint8_t * decompressFont(const uint8_t * font, unsigned len)
     *dst = 0xFF - *src;
   }    
 #endif
-  
+
+  free(raw_font);
   return buf;
 }
 
+// libopenui draws straight from fontsTable[], a font has to be loaded
+// before anything is drawn with it and can't be freed while drawing
+const uint8_t * loadFont(unsigned index)
+{
+  if (!fontsTable[index]) {
+    fontsTable[index] = decompressFont(fontsCompressedTable[index], fontsSizeTable[index]);
+  }
+
+  return fontsTable[index];
+}
+
 void loadFonts()
 {
-  static bool fontsLoaded = false;
-  if (fontsLoaded)
-    return;
+  loadFont(FONT_STD_INDEX);
+}
 
-#if defined(BOOT)
-  fontsTable[0] = decompressFont(fontsTable[0], fontsSizeTable[0]);
-#else
-  for (int i = 0; i < FONTS_COUNT; i++) {
-    fontsTable[i] = decompressFont(fontsTable[i], fontsSizeTable[i]);
+void loadAllFonts()
+{
+  for (unsigned i = 0; i < FONTS_COUNT; i++) {
+    loadFont(i);
   }
-#endif
+}
 
-  fontsLoaded = true;
+void unloadFonts()
+{
+  for (unsigned i = 0; i < FONTS_COUNT; i++) {
+    free((void *)fontsTable[i]);
+    fontsTable[i] = nullptr;
+  }
 }
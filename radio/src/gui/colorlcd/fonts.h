@@ -21,4 +21,12 @@
 
 #pragma once
 
+#include <inttypes.h>
+
+// Decompress the standard font, enough for the boot screens
 void loadFonts();
+// Decompress the fonts not loaded yet, before the windows are drawn
+void loadAllFonts();
+// Only safe while nothing is being drawn
+void unloadFonts();
+const uint8_t * loadFont(unsigned index);
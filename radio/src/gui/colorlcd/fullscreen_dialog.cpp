@@ -23,6 +23,7 @@
 #include "mainwindow.h"
 #include "opentx.h"
 #include "libopenui.h"
+#include "fonts.h"
 
 FullScreenDialog::FullScreenDialog(
     uint8_t type, std::string title, std::string message, std::string action,
@@ -156,6 +157,8 @@ void FullScreenDialog::deleteLater(bool detach, bool trash)
 
 void FullScreenDialog::runForever()
 {
+  // may run during the boot, before the menus task has loaded the fonts
+  loadAllFonts();
   running = true;
 
   while (running) {
@@ -184,6 +187,7 @@ void FullScreenDialog::runForever()
 
 void FullScreenDialog::runForeverNoPwrCheck()
 {
+  loadAllFonts();
   running = true;
 
   while (running) {
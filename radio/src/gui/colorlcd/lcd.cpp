@@ -49,9 +49,29 @@ uint8_t getFontHeight(LcdFlags flags)
   return fontspecsTable[fontindex][0];
 }
 
+// Advance of each single byte character (0 when missing from the font),
+// computed once per font instead of subtracting the specs on every call
+static uint8_t fontCharWidths[FONTS_COUNT][0xFE - 0x20];
+static bool fontCharWidthsReady[FONTS_COUNT];
+
+static const uint8_t * getFontCharWidths(uint32_t fontindex)
+{
+  uint8_t * widths = fontCharWidths[fontindex];
+  if (!fontCharWidthsReady[fontindex]) {
+    const uint16_t * specs = fontspecsTable[fontindex];
+    for (unsigned c = 0x20; c < 0xFE; c++) {
+      widths[c - 0x20] = (c < fontCharactersTable[fontindex] + 0x20u) ? getCharWidth(c, specs) : 0;
+    }
+    fontCharWidthsReady[fontindex] = true;
+  }
+  return widths;
+}
+
 int getTextWidth(const char * s, int len, LcdFlags flags)
 {
-  const uint16_t * specs = fontspecsTable[FONT_INDEX(flags)];
+  uint32_t fontindex = FONT_INDEX(flags);
+  const uint16_t * specs = fontspecsTable[fontindex];
+  const uint8_t * widths = getFontCharWidths(fontindex);
 
   int result = 0;
   for (int i = 0; len == 0 || i < len; ++i) {
@@ -67,8 +87,8 @@ int getTextWidth(const char * s, int len, LcdFlags flags)
       c += CJK_FIRST_LETTER_INDEX;
       result += getFontPatternWidth(specs, c) + 1;
     }
-    else if ((c >= 0x20u) && (c < fontCharactersTable[FONT_INDEX(flags)] + 0x20u)) {
-      result += getCharWidth(c, specs);
+    else if (c >= 0x20u && widths[c - 0x20]) {
+      result += widths[c - 0x20];
     }
     else {
       TRACE("char out-of bound: 0x%X", c);
@@ -327,6 +327,7 @@ void GVarEditWindow::buildBody(FormWindow * window)
       auto cb = new CheckBox(window, grid.getFieldSlot(2, 0),
                              [=] { return fmData->gvars[index] <= GVAR_MAX; }, [=](uint8_t checked) {
             fmData->gvars[index] = checked ? 0 : GVAR_MAX + 1;
+            storageDirty(EE_MODEL);
             setProperties(flightMode);
         });
       cb->setLabel(STR_OWN);
@@ -147,6 +147,10 @@ const char * runPopupMenu(event_t event)
 
     case EVT_KEY_BREAK(KEY_ENTER):
       result = popupMenuItems[popupMenuSelectedItem + (popupMenuOffsetType == MENU_OFFSET_INTERNAL ? popupMenuOffset : 0)];
+#if defined(SDCARD)
+      // give the RAM used by the SD files listing back
+      dirCache.invalidate();
+#endif
       popupMenuItemsCount = 0;
       popupMenuSelectedItem = 0;
       popupMenuOffset = 0;
@@ -155,6 +159,9 @@ const char * runPopupMenu(event_t event)
 
     case EVT_KEY_BREAK(KEY_EXIT):
       result = STR_EXIT;
+#if defined(SDCARD)
+      dirCache.invalidate();
+#endif
       popupMenuItemsCount = 0;
       popupMenuSelectedItem = 0;
       popupMenuOffset = 0;
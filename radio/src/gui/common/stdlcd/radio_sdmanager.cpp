@@ -191,6 +191,7 @@ void onSdManagerMenu(const char * result)
   else if (result == STR_DELETE_FILE) {
     getSelectionFullPath(lfn);
     f_unlink(lfn);
+    dirCache.invalidate();
     strncpy(statusLineMsg, line, 13);
     strcpy(statusLineMsg+min((uint8_t)strlen(statusLineMsg), (uint8_t)13), STR_REMOVED);
     showStatusLine();
@@ -605,6 +606,7 @@ void menuRadioSdManager(event_t _event)
               reusableBuffer.sdManager.lines[i][efflen] = 0;
             }
             f_rename(reusableBuffer.sdManager.originalName, reusableBuffer.sdManager.lines[i]);
+            dirCache.invalidate();
             REFRESH_FILES();
           }
         }
@@ -72,6 +72,8 @@ const char * writeScreenshot()
     return SDCARD_ERROR(result);
   }
 
+  dirCacheInvalidate();
+
   result = f_write(&bmpFile, BMP_HEADER, sizeof(BMP_HEADER), &written);
   if (result != FR_OK || written != sizeof(BMP_HEADER)) {
     f_close(&bmpFile);
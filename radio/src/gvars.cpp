@@ -24,7 +24,15 @@
 uint8_t gvarDisplayTimer = 0;
 uint8_t gvarLastChanged = 0;
 
-uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+// Flight mode actually holding each GVar value, and that value, for each
+// flight mode. Rebuilt by the mixer once per tick after the model changed
+// (see storageDirty), or on first use from another task
+static uint8_t gvarFlightModes[MAX_FLIGHT_MODES][MAX_GVARS];
+static int16_t gvarValues[MAX_FLIGHT_MODES][MAX_GVARS];
+static uint32_t gvarCacheSerial = 1;
+static uint32_t gvarCacheBuiltSerial = 0;
+
+static uint8_t resolveGVarFlightMode(uint8_t fm, uint8_t gv)
 {
   for (uint8_t i=0; i<MAX_FLIGHT_MODES; i++) {
     if (fm == 0) return 0;
@@ -37,6 +45,49 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+void invalidateGVarCache()
+{
+  gvarCacheSerial++;
+}
+
+static void buildGVarCache()
+{
+  uint32_t serial = gvarCacheSerial;
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv=0; gv<MAX_GVARS; gv++) {
+      uint8_t result = resolveGVarFlightMode(fm, gv);
+      gvarFlightModes[fm][gv] = result;
+      gvarValues[fm][gv] = GVAR_VALUE(gv, result);
+    }
+  }
+  // a change during the rebuild leaves the cache invalid
+  gvarCacheBuiltSerial = serial;
+}
+
+void updateGVarCache()
+{
+  if (gvarCacheBuiltSerial != gvarCacheSerial)
+    buildGVarCache();
+}
+
+uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+{
+  if (fm >= MAX_FLIGHT_MODES || gv >= MAX_GVARS)
+    return resolveGVarFlightMode(fm, gv);
+
+  updateGVarCache();
+  return gvarFlightModes[fm][gv];
+}
+
+static int16_t getResolvedGVarValue(uint8_t gv, uint8_t fm)
+{
+  if (fm >= MAX_FLIGHT_MODES || gv >= MAX_GVARS)
+    return GVAR_VALUE(gv, resolveGVarFlightMode(fm, gv));
+
+  updateGVarCache();
+  return gvarValues[fm][gv];
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
@@ -44,7 +95,7 @@ int16_t getGVarValue(int8_t gv, int8_t fm)
     gv = -1-gv;
     mul = -1;
   }
-  return GVAR_VALUE(gv, getGVarFlightMode(fm, gv)) * mul;
+  return getResolvedGVarValue(gv, fm) * mul;
 }
 
 int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
@@ -54,7 +105,7 @@ int32_t getGVarValuePrec1(int8_t gv, int8_t fm)
   if (gv < 0) {
     mul = -mul;
   }
-  return GVAR_VALUE(idx, getGVarFlightMode(fm, idx)) * mul;
+  return getResolvedGVarValue(idx, fm) * mul;
 }
 
 void setGVarValue(uint8_t gv, int16_t value, int8_t fm)
@@ -34,6 +34,8 @@
 
 #if defined(GVARS)
     uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv);
+    void invalidateGVarCache();
+    void updateGVarCache();
     int16_t getGVarFieldValue(int16_t x, int16_t min, int16_t max, int8_t fm);
     int32_t getGVarFieldValuePrec1(int16_t x, int16_t min, int16_t max, int8_t fm);
     int16_t getGVarValue(int8_t gv, int8_t fm);
@@ -20,35 +20,22 @@
  */
 
 #include "opentx.h"
-#define _USE_MATH_DEFINES
-#include <math.h>
 
-#define ACC_LSB_VALUE	0.000488  // 0.488 mg/LSB
+// Gyro gain for the tilt filter, angle units (Q16) per LSB per sample
+constexpr uint32_t GYRO_TILT_GAIN = ((uint64_t)GYRO_RATE_MDPS_PER_LSB * TILT_PI << 16) / (180 * 1000 * GYRO_SAMPLE_RATE);
 
-Gyro gyro;
-
-int GyroBuffer::read(int32_t values[GYRO_VALUES_COUNT])
-{
-  index = (index + 1) & (GYRO_SAMPLES_COUNT - 1);
+// The accelerometer gives the tilt only while it measures gravity alone
+constexpr int64_t GYRO_ACC_MIN = (int64_t)GYRO_ACC_LSB_PER_G * GYRO_ACC_LSB_PER_G * 9 / 16;   // (0.75g)^2
+constexpr int64_t GYRO_ACC_MAX = (int64_t)GYRO_ACC_LSB_PER_G * GYRO_ACC_LSB_PER_G * 25 / 16;  // (1.25g)^2
 
-  for (uint8_t i = 0; i < GYRO_VALUES_COUNT; i++) {
-    sums[i] -= samples[index].values[i];
-  }
-
-  if (gyroRead(samples[index].raw) < 0)
-    return -1;
-
-  for (uint8_t i = 0; i < GYRO_VALUES_COUNT; i++) {
-    sums[i] += samples[index].values[i];
-    values[i] = sums[i] >> GYRO_SAMPLES_EXPONENT;
-  }
+static_assert(RESX == TILT_PI >> TILT_OUTPUT_SHIFT, "Tilt filter output must be in RESX units");
 
-  return 0;
-}
+Gyro gyro;
 
-float rad2RESX(float rad)
+Gyro::Gyro():
+  tiltX(GYRO_TILT_GAIN),
+  tiltY(GYRO_TILT_GAIN)
 {
-  return (rad * float(RESX)) / M_PI;
 }
 
 void Gyro::wakeup()
@@ -61,17 +48,25 @@ void Gyro::wakeup()
 
   gyroWakeupTime = now + 1; /* 10ms default */
 
-  int32_t values[GYRO_VALUES_COUNT];
-  if (gyroBuffer.read(values) < 0)
+  // samples queued in the IMU FIFO since the last call, oldest first
+  int16_t samples[GYRO_FIFO_SAMPLES][GYRO_VALUES_COUNT];
+  int count = gyroReadFifo(samples, GYRO_FIFO_SAMPLES);
+  if (count < 0) {
     ++errors;
+    return;
+  }
 
-  float accValues[3]; // m^2 / s
-  accValues[0] = -9.81 * float(values[3]) * ACC_LSB_VALUE;
-  accValues[1] = 9.81 * float(values[4]) * ACC_LSB_VALUE;
-  accValues[2] = 9.81 * float(values[5]) * ACC_LSB_VALUE;
-
-  outputs[0] = rad2RESX(atan2f(accValues[1], accValues[2]));
-  outputs[1] = rad2RESX(atan2f(-accValues[0], accValues[2]));
+  for (int i = 0; i < count; i++) {
+    // gyro X, Y, Z then accelerometer X, Y, Z
+    const int16_t * values = samples[i];
+    int64_t acc = (int64_t)values[3] * values[3] + (int64_t)values[4] * values[4] + (int64_t)values[5] * values[5];
+    bool accValid = (acc >= GYRO_ACC_MIN && acc <= GYRO_ACC_MAX);
+    tiltX.update(values[0], values[4], values[5], accValid);
+    tiltY.update(-values[1], values[3], values[5], accValid);
+  }
 
-  // TRACE("%d %d", values[0], values[1]);
+  if (count > 0) {
+    outputs[0] = tiltX.angle();
+    outputs[1] = tiltY.angle();
+  }
 }
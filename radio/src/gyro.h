@@ -21,32 +21,19 @@
 
 #include <inttypes.h>
 #include "myeeprom.h"
-
-#define GYRO_SAMPLES_EXPONENT  3
-#define GYRO_SAMPLES_COUNT     (2 ^ GYRO_SAMPLES_EXPONENT)
-
-class GyroBuffer {
-  protected:
-    union {
-      int16_t values[GYRO_VALUES_COUNT];
-      uint8_t raw[GYRO_BUFFER_LENGTH];
-    } samples[GYRO_SAMPLES_COUNT];
-
-    int32_t sums[GYRO_VALUES_COUNT];
-
-    uint8_t index;
-
-  public:
-    int read(int32_t values[GYRO_VALUES_COUNT]);
-};
+#include "tilt_filter.h"
 
 class Gyro {
   protected:
-    GyroBuffer gyroBuffer;
+    TiltFilter tiltX;
+    TiltFilter tiltY;
     uint8_t errors = 0;
 
   public:
-    int16_t outputs[2];
+    Gyro();
+
+    int16_t outputs[2];   // tilt, RESX = 180deg
+
     void wakeup();
 
     int16_t scaledX()
@@ -454,6 +454,9 @@ const char * FrskyDeviceFirmwareUpdate::uploadFileNormal(const char * filename,
   startFrame(PRIM_CMD_DOWNLOAD);
   sendFrame();
 
+  tmr10ms_t start = get_tmr10ms();
+  uint32_t written = 0;
+
   while (true) {
     if (f_read(file, buffer, 1024, &count) != FR_OK) {
       return "Error reading file";
@@ -476,12 +479,19 @@ const char * FrskyDeviceFirmwareUpdate::uploadFileNormal(const char * filename,
       }
     }
 
+    written += count << 2;
+
     if (count < 256) {
       break;
     }
   }
 
-  return endTransfer();
+  result = endTransfer();
+
+  tmr10ms_t duration = get_tmr10ms() - start;
+  TRACE("FrSky flash: %d bytes in %d0ms (%d bytes/s)", written, duration, duration ? written * 100 / duration : 0);
+
+  return result;
 }
 
 const char * FrskyDeviceFirmwareUpdate::endTransfer()
@@ -43,30 +43,6 @@
 
 #define UPDATE_MULTI_EXT_BIN ".bin"
 
-class MultiFirmwareUpdateDriver
-{
-  public:
-    MultiFirmwareUpdateDriver() {}
-    const char * flashFirmware(FIL * file, const char * label, ProgressHandler progressHandler) const;
-
-  protected:
-    virtual void moduleOn() const = 0;
-    virtual void init(bool inverted) const = 0;
-    virtual bool getByte(uint8_t & byte) const = 0;
-    virtual void sendByte(uint8_t byte) const = 0;
-    virtual void clear() const = 0;
-    virtual void deinit(bool inverted) const {}
-
-  private:
-    bool getRxByte(uint8_t & byte) const;
-    bool checkRxByte(uint8_t byte) const;
-    const char * waitForInitialSync(bool& inverted) const;
-    const char * getDeviceSignature(uint8_t * signature) const;
-    const char * loadAddress(uint32_t offset) const;
-    const char * progPage(uint8_t * buffer, uint16_t size) const;
-    void leaveProgMode(bool inverted) const;
-};
-
 #if defined(INTERNAL_MODULE_MULTI)
 class MultiInternalUpdateDriver: public MultiFirmwareUpdateDriver
 {
@@ -327,7 +303,7 @@ const char * MultiFirmwareUpdateDriver::loadAddress(uint32_t offset) const
   return nullptr;
 }
 
-const char * MultiFirmwareUpdateDriver::progPage(uint8_t * buffer, uint16_t size) const
+void MultiFirmwareUpdateDriver::sendPage(const uint8_t * buffer, uint16_t size) const
 {
   sendByte(STK_PROG_PAGE);
 
@@ -343,7 +319,11 @@ const char * MultiFirmwareUpdateDriver::progPage(uint8_t * buffer, uint16_t size
   }
 
   sendByte(CRC_EOP);
+}
 
+// The answer is queued in the RX fifo while the module writes the page
+const char * MultiFirmwareUpdateDriver::checkPageWritten() const
+{
   if (!checkRxByte(STK_INSYNC))
     return "NoSync";
 
@@ -370,6 +350,59 @@ void MultiFirmwareUpdateDriver::leaveProgMode(bool inverted) const
   deinit(inverted);
 }
 
+const char * MultiFirmwareUpdateDriver::writePages(FIL * file, uint16_t pageSize, uint32_t writeOffset, const char * label, ProgressHandler progressHandler) const
+{
+  const char * result = nullptr;
+  uint8_t buffers[2][256];
+  uint8_t current = 0;
+
+  tmr10ms_t start = get_tmr10ms();
+  uint32_t written = 0;
+
+  UINT count = 0;
+  memclear(buffers[current], pageSize);
+  if (f_read(file, buffers[current], pageSize, &count) != FR_OK) {
+    return "Error reading file";
+  }
+
+  while (count) {
+    progressHandler(label, STR_WRITING, written, file->obj.objsize);
+
+    clear();
+
+    result = loadAddress(writeOffset);
+    if (result) {
+      return result;
+    }
+
+    sendPage(buffers[current], pageSize);
+
+    // read the next page while the module writes this one
+    uint8_t next = current ^ 1;
+    UINT nextCount = 0;
+    memclear(buffers[next], pageSize);
+    if (f_read(file, buffers[next], pageSize, &nextCount) != FR_OK) {
+      return "Error reading file";
+    }
+
+    result = checkPageWritten();
+    if (result) {
+      return result;
+    }
+
+    written += count;
+    writeOffset += pageSize / 2;
+    current = next;
+    count = nextCount;
+  }
+
+  progressHandler(label, STR_WRITING, written, file->obj.objsize);
+  tmr10ms_t duration = get_tmr10ms() - start;
+  TRACE("Multi flash: %d bytes in %d0ms (%d bytes/s)", written, duration, duration ? written * 100 / duration : 0);
+
+  return nullptr;
+}
+
 const char * MultiFirmwareUpdateDriver::flashFirmware(FIL * file, const char * label, ProgressHandler progressHandler) const
 {
 #if defined(SIMU)
@@ -404,7 +437,6 @@ const char * MultiFirmwareUpdateDriver::flashFirmware(FIL * file, const char * l
     return result;
   }
 
-  uint8_t buffer[256];
   uint16_t pageSize = 128;
   uint32_t writeOffset = 0;
 
@@ -418,37 +450,7 @@ const char * MultiFirmwareUpdateDriver::flashFirmware(FIL * file, const char * l
     writeOffset = 0x1000; // start offset (word address)
   }
 
-  while (!f_eof(file)) {
-    progressHandler(label, STR_WRITING, file->fptr, file->obj.objsize);
-
-    UINT count = 0;
-    memclear(buffer, pageSize);
-    if (f_read(file, buffer, pageSize, &count) != FR_OK) {
-      result = "Error reading file";
-      break;
-    }
-
-    if (!count)
-      break;
-
-    clear();
-
-    result = loadAddress(writeOffset);
-    if (result) {
-      break;
-    }
-
-    result = progPage(buffer, pageSize);
-    if (result) {
-      break;
-    }
-
-    writeOffset += pageSize / 2;
-  }
-
-  if (f_eof(file)) {
-    progressHandler(label, STR_WRITING, file->fptr, file->obj.objsize);
-  }
+  result = writePages(file, pageSize, writeOffset, label, progressHandler);
 
   leaveProgMode(inverted);
   return result;
@@ -104,6 +104,34 @@ class MultiFirmwareInformation
     const char * readV2Signature(const char * buffer);
 };
 
+class MultiFirmwareUpdateDriver
+{
+  public:
+    MultiFirmwareUpdateDriver() {}
+    const char * flashFirmware(FIL * file, const char * label, ProgressHandler progressHandler) const;
+
+  protected:
+    virtual void moduleOn() const = 0;
+    virtual void init(bool inverted) const = 0;
+    virtual bool getByte(uint8_t & byte) const = 0;
+    virtual void sendByte(uint8_t byte) const = 0;
+    virtual void clear() const = 0;
+    virtual void deinit(bool inverted) const {}
+
+    // sends the file page by page, reading the next page while the module writes the current one
+    const char * writePages(FIL * file, uint16_t pageSize, uint32_t writeOffset, const char * label, ProgressHandler progressHandler) const;
+
+  private:
+    bool getRxByte(uint8_t & byte) const;
+    bool checkRxByte(uint8_t byte) const;
+    const char * waitForInitialSync(bool& inverted) const;
+    const char * getDeviceSignature(uint8_t * signature) const;
+    const char * loadAddress(uint32_t offset) const;
+    void sendPage(const uint8_t * buffer, uint16_t size) const;
+    const char * checkPageWritten() const;
+    void leaveProgMode(bool inverted) const;
+};
+
 enum MultiModuleType : short
 {
   MULTI_TYPE_MULTIMODULE = 0,
@@ -111,6 +111,8 @@ const char * logsOpen()
   }
 
   if (f_size(&g_oLogFile) == 0) {
+    // new file
+    dirCacheInvalidate();
     writeHeader();
   }
 
@@ -888,13 +888,15 @@ Return the internal GPS position or nil if no valid hardware found
  * 'speed' (number) internal GPSspeed in 0.1m/s
  * 'heading'  (number) internal GPS ground course estimation in degrees * 10
  * 'hdop' (number)  internal GPS horizontal dilution of precision
+ * 'age' (number) time since the last position in ms, nil if none was received
+ * 'period' (number) time between the last two positions in ms
 
 @status current Introduced in 2.2.2
 */
 static int luaGetTxGPS(lua_State * L)
 {
 #if defined(INTERNAL_GPS)
-  lua_createtable(L, 0, 8);
+  lua_createtable(L, 0, 10);
   lua_pushtablenumber(L, "lat", gpsData.latitude * 0.000001);
   lua_pushtablenumber(L, "lon", gpsData.longitude * 0.000001);
   lua_pushtableinteger(L, "numsat", gpsData.numSat);
@@ -902,6 +904,9 @@ static int luaGetTxGPS(lua_State * L)
   lua_pushtableinteger(L, "speed", gpsData.speed);
   lua_pushtableinteger(L, "heading", gpsData.groundCourse);
   lua_pushtableinteger(L, "hdop", gpsData.hdop);
+  if (gpsData.fixTime)
+    lua_pushtableinteger(L, "age", gpsGetFixAge());
+  lua_pushtableinteger(L, "period", gpsData.updatePeriod);
   if (gpsData.fix)
     lua_pushtableboolean(L, "fix", true);
   else
@@ -1575,12 +1580,23 @@ Get percent of already used Lua instructions in current script execution cycle.
 
 @retval usage (number) a value from 0 to 100 (percent)
 
-@status current Introduced in 2.2.1
+@retval memory (number) memory used by the calling script in bytes (all
+widgets share the same value), only on radios with a Lua memory arena
+
+@status current Introduced in 2.2.1, memory added in EdgeTX 2.6
 */
 static int luaGetUsage(lua_State * L)
 {
   lua_pushinteger(L, instructionsPercent);
+#if defined(LUA_ARENA_SIZE)
+  uint8_t owner = luaArenaGetOwner();
+  if (owner == LUA_ARENA_OWNER_SYSTEM)
+    owner = LUA_ARENA_OWNER_WIDGETS;  // widgets don't set an owner
+  lua_pushunsigned(L, luaArenaGetUsage(owner));
+  return 2;
+#else
   return 1;
+#endif
 }
 
 /*luadoc
@@ -1716,9 +1732,7 @@ static int luaSerialWrite(lua_State * L)
 
 #if defined(USB_SERIAL)
   if (getSelectedUsbMode() == USB_SERIAL_MODE) {
-    size_t wr_len = len;
-    const char* p = str;
-    while(wr_len--) usbSerialPutc(*p++);
+    usbSerialWrite((const uint8_t *)str, len);
   }
 #endif
 
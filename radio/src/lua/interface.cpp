@@ -394,6 +394,7 @@ static void luaDumpState(lua_State * L, const char * filename, const FILINFO * f
 {
   FIL D;
   if (f_open(&D, filename, FA_WRITE | FA_CREATE_ALWAYS) == FR_OK) {
+    dirCacheInvalidate();
     lua_lock(L);
     luaU_dump(L, getproto(L->top - 1), luaDumpWriter, &D, stripDebug);
     lua_unlock(L);
@@ -577,7 +578,7 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
 }
 
 // Get the name of a script for error reporting etc.
-static const char * getScriptName(uint8_t idx)
+const char * luaGetScriptName(uint8_t idx)
 {
   int ref = scriptInternalData[idx].reference;
 
@@ -604,7 +605,9 @@ static const char * getScriptName(uint8_t idx)
 
 static bool luaLoad(const char * filename, ScriptInternalData & sid)
 {
+  luaArenaSetOwner(&sid - scriptInternalData);
   sid.state = luaLoadScriptFileToState(lsScripts, filename, LUA_SCRIPT_LOAD_MODE);
+  luaArenaSetOwner(LUA_ARENA_OWNER_SYSTEM);
 
   if (sid.state != SCRIPT_OK) {
     luaFree(lsScripts, sid);
@@ -724,6 +727,9 @@ void displayLuaError(bool firstCall = false)
     case SCRIPT_PANIC:
       title = STR_SCRIPT_PANIC;
       break;
+    case SCRIPT_KILLED:
+      title = STR_SCRIPT_KILLED;
+      break;
     default:
       title = STR_SCRIPT_ERROR;
   }
@@ -819,7 +825,7 @@ static int luaRegisterFunction(const char * key)
   }
   else {
     if (typ != LUA_TNIL) {
-      TRACE_ERROR("luaRegisterFunction(%s): Error: '%s' is not a function\n", getScriptName(luaScriptsCount - 1), key);
+      TRACE_ERROR("luaRegisterFunction(%s): Error: '%s' is not a function\n", luaGetScriptName(luaScriptsCount - 1), key);
     }
     lua_pop(lsScripts, 1);
     return LUA_NOREF;
@@ -902,7 +908,9 @@ static void luaLoadScripts(bool init, const char * filename = nullptr)
     // 1. run chunk() 2. run init(), if available:
     do {
       // Resume running the coroutine
+      luaArenaSetOwner(idx);
       luaStatus = lua_resume(lsScripts, 0, 0);
+      luaArenaSetOwner(LUA_ARENA_OWNER_SYSTEM);
      
       if (luaStatus == LUA_YIELD) {
         // Coroutine yielded - wait for the next cycle
@@ -926,7 +934,7 @@ static void luaLoadScripts(bool init, const char * filename = nullptr)
             sid.background = luaRegisterFunction("background");
             initFunction = luaRegisterFunction("init");
             if (sid.run == LUA_NOREF) {
-              snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%s): No run function\n", getScriptName(idx));
+              snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%s): No run function\n", luaGetScriptName(idx));
               sid.state = SCRIPT_SYNTAX_ERROR;
               initFunction = LUA_NOREF;
             }
@@ -944,7 +952,7 @@ static void luaLoadScripts(bool init, const char * filename = nullptr)
 #endif
           }
           else {
-            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%s): The script did not return a table\n", getScriptName(idx));
+            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%s): The script did not return a table\n", luaGetScriptName(idx));
             sid.state = SCRIPT_SYNTAX_ERROR;
             initFunction = LUA_NOREF;
           }
@@ -1157,7 +1165,9 @@ static bool resumeLua(bool init, bool allowLcdUsage)
     fullGC = false;
 
     // Resume running the coroutine
+    luaArenaSetOwner(idx);
     luaStatus = lua_resume(lsScripts, 0, inputsCount);
+    luaArenaSetOwner(LUA_ARENA_OWNER_SYSTEM);
 
     if (luaStatus == LUA_YIELD) {
       // Coroutine yielded - wait for the next cycle
@@ -1175,7 +1185,7 @@ static bool resumeLua(bool init, bool allowLcdUsage)
         for (int j = sio -> outputsCount - 1; j >= 0; j--) {
           if (!lua_isnumber(lsScripts, -1)) {
             sid.state = SCRIPT_SYNTAX_ERROR;
-            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "Script %s: run function did not return a number\n", getScriptName(idx));
+            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "Script %s: run function did not return a number\n", luaGetScriptName(idx));
             luaError(lsScripts, sid.state);
             break;
           }
@@ -1305,13 +1315,72 @@ bool luaTask(event_t evt, bool allowLcdUsage)
   return scriptWasRun;
 }
 
-void checkLuaMemoryUsage()
-{
 #if (LUA_MEM_MAX > 0)
+static uint32_t luaGetTotalMemUsed()
+{
   uint32_t totalMemUsed = luaGetMemUsed(lsScripts);
 #if defined(COLORLCD)
   totalMemUsed += luaGetMemUsed(lsWidgets);
   totalMemUsed += luaExtraMemoryUsage;
+#endif
+  return totalMemUsed;
+}
+#endif
+
+#if defined(LUA_ARENA_SIZE)
+// Kill the script using the most memory, if it uses more than the widgets
+static bool luaKillBiggestScript()
+{
+  if (!lsScripts)
+    return false;
+
+  int biggest = -1;
+  uint32_t biggestUsage = luaArenaGetUsage(LUA_ARENA_OWNER_WIDGETS);
+  for (int i = 0; i < luaScriptsCount; i++) {
+    uint32_t usage = luaArenaGetUsage(i);
+    if (scriptInternalData[i].state == SCRIPT_OK && usage > biggestUsage) {
+      biggest = i;
+      biggestUsage = usage;
+    }
+  }
+
+  if (biggest < 0)
+    return false;
+
+  ScriptInternalData & sid = scriptInternalData[biggest];
+  TRACE_ERROR("checkLuaMemoryUsage(): killing %s (%u bytes)\n", luaGetScriptName(biggest), biggestUsage);
+
+  if (lua_status(lsScripts) == LUA_YIELD) {
+    // Replace the preempted coroutine, it may hold the killed script
+    lua_pop(L, 1);
+    lsScripts = lua_newthread(L);
+  }
+  sid.state = SCRIPT_KILLED;
+  luaFree(lsScripts, sid);
+
+  snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "%s: not enough memory\n", luaGetScriptName(biggest));
+  errorState = SCRIPT_KILLED;
+  displayLuaError(true);
+  return true;
+}
+#endif
+
+void checkLuaMemoryUsage()
+{
+#if (LUA_MEM_MAX > 0)
+  uint32_t totalMemUsed = luaGetTotalMemUsed();
+#if defined(LUA_ARENA_SIZE)
+  if (totalMemUsed > LUA_MEM_MAX) {
+    // first try to get rid of the garbage, then of the greediest script
+    luaDoGc(lsScripts, true);
+#if defined(COLORLCD)
+    luaDoGc(lsWidgets, true);
+#endif
+    totalMemUsed = luaGetTotalMemUsed();
+    if (totalMemUsed > LUA_MEM_MAX && luaKillBiggestScript()) {
+      totalMemUsed = luaGetTotalMemUsed();
+    }
+  }
 #endif
   if (totalMemUsed > LUA_MEM_MAX) {
     TRACE_ERROR("checkLuaMemoryUsage(): max limit reached (%u), killing Lua\n", totalMemUsed);
@@ -1345,6 +1414,8 @@ void luaInit()
     memclear(&lsScriptsTrace, sizeof(lsScriptsTrace);
     lsScriptsTrace.script = "lua_newstate(scripts)";
     L = lua_newstate(tracer_alloc, &lsScriptsTrace);   //we use tracer allocator
+#elif defined(LUA_ARENA_SIZE)
+    L = lua_newstate(luaArenaAlloc, nullptr);   //we use the arena, blocks owned by the running script
 #else
     L = lua_newstate(l_alloc, nullptr);   //we use Lua default allocator
 #endif
@@ -37,6 +37,7 @@ extern "C" {
 
 #include "dataconstants.h"
 #include "opentx_types.h"
+#include "lua_arena.h"
 
 #ifndef LUA_SCRIPT_LOAD_MODE
   // Can force loading of binary (.luac) or plain-text (.lua) versions of scripts specifically, and control
@@ -116,7 +117,8 @@ enum ScriptState {
   SCRIPT_OK,
   SCRIPT_NOFILE,
   SCRIPT_SYNTAX_ERROR,
-  SCRIPT_PANIC
+  SCRIPT_PANIC,
+  SCRIPT_KILLED
 };
 
 enum ScriptReference {
@@ -172,6 +174,7 @@ void checkLuaMemoryUsage();
 void luaExec(const char * filename);
 void luaDoGc(lua_State * L, bool full);
 uint32_t luaGetMemUsed(lua_State * L);
+const char * luaGetScriptName(uint8_t idx);
 void luaGetValueAndPush(lua_State * L, int src);
 bool isTelemetryScriptAvailable();
 
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "opentx.h"
+
+#if defined(LUA_ARENA_SIZE)
+
+#define LUA_ARENA_ALIGN       8
+#define LUA_ARENA_PAGE_SIZE   2048  // bytes taken from the arena at once by a pool
+#define LUA_ARENA_MAX_BLOCK   256   // bigger blocks are allocated from the heap
+#define LUA_ARENA_CLASSES     (LUA_ARENA_MAX_BLOCK / LUA_ARENA_ALIGN)
+
+static_assert(LUA_ARENA_SIZE % LUA_ARENA_PAGE_SIZE == 0, "LUA_ARENA_SIZE must be a multiple of the page size");
+
+// In front of each block, keeps the payload aligned on LUA_ARENA_ALIGN
+struct LuaBlockHeader {
+  uint32_t size;  // payload size as requested by Lua
+  uint8_t owner;
+  uint8_t spare[3];
+};
+
+static_assert(sizeof(LuaBlockHeader) == LUA_ARENA_ALIGN, "Bad LuaBlockHeader size");
+
+struct LuaFreeBlock {
+  LuaFreeBlock * next;
+};
+
+static uint64_t luaArenaData[LUA_ARENA_SIZE / sizeof(uint64_t)] __SDRAM;
+
+// Only used from the task running Lua, no locking needed
+static struct {
+  uint8_t * top;  // first byte not given to a pool yet
+  LuaFreeBlock * freeList[LUA_ARENA_CLASSES];
+  uint8_t * pageNext[LUA_ARENA_CLASSES];  // next block to carve from the current page
+  uint32_t pageLeft[LUA_ARENA_CLASSES];
+  uint32_t poolsFree;
+  uint32_t arenaBlocks;
+  uint32_t heapBlocks;
+  uint32_t heapUsed;
+  uint32_t usage[LUA_ARENA_OWNERS];
+} luaArena;
+
+static uint8_t luaArenaOwner = LUA_ARENA_OWNER_SYSTEM;
+
+static inline uint8_t * arenaStart()
+{
+  return (uint8_t *)luaArenaData;
+}
+
+static inline bool isArenaBlock(const void * block)
+{
+  return block >= (const void *)luaArenaData && block < (const void *)(luaArenaData + DIM(luaArenaData));
+}
+
+// Returns LUA_ARENA_CLASSES for the blocks which don't fit in the pools
+static inline unsigned blockClass(size_t size)
+{
+  size_t total = size + sizeof(LuaBlockHeader);
+  return total <= LUA_ARENA_MAX_BLOCK ? (total - 1) / LUA_ARENA_ALIGN : LUA_ARENA_CLASSES;
+}
+
+static inline uint32_t classSize(unsigned cls)
+{
+  return (cls + 1) * LUA_ARENA_ALIGN;
+}
+
+static uint32_t blockFootprint(const LuaBlockHeader * block)
+{
+  return isArenaBlock(block) ? classSize(blockClass(block->size)) : block->size + sizeof(LuaBlockHeader);
+}
+
+static void arenaReset()
+{
+  luaArena.top = arenaStart();
+  memclear(luaArena.freeList, sizeof(luaArena.freeList));
+  memclear(luaArena.pageLeft, sizeof(luaArena.pageLeft));
+  luaArena.poolsFree = 0;
+}
+
+static void * poolMalloc(unsigned cls)
+{
+  LuaFreeBlock * block = luaArena.freeList[cls];
+  if (block) {
+    luaArena.freeList[cls] = block->next;
+    luaArena.poolsFree -= classSize(cls);
+    return block;
+  }
+
+  uint32_t size = classSize(cls);
+  if (luaArena.pageLeft[cls] < size) {
+    if (!luaArena.top) {
+      arenaReset();
+    }
+    if (luaArena.top + LUA_ARENA_PAGE_SIZE > arenaStart() + sizeof(luaArenaData)) {
+      return nullptr;
+    }
+    // the end of the previous page, if any, is lost until the next reset
+    luaArena.pageNext[cls] = luaArena.top;
+    luaArena.pageLeft[cls] = LUA_ARENA_PAGE_SIZE;
+    luaArena.top += LUA_ARENA_PAGE_SIZE;
+  }
+
+  void * result = luaArena.pageNext[cls];
+  luaArena.pageNext[cls] += size;
+  luaArena.pageLeft[cls] -= size;
+  return result;
+}
+
+static LuaBlockHeader * blockMalloc(size_t size, uint8_t owner)
+{
+  LuaBlockHeader * block = nullptr;
+
+  unsigned cls = blockClass(size);
+  if (cls < LUA_ARENA_CLASSES) {
+    block = (LuaBlockHeader *)poolMalloc(cls);
+    if (block) {
+      luaArena.arenaBlocks++;
+    }
+  }
+
+  if (!block) {
+    // big block, or arena full
+    block = (LuaBlockHeader *)malloc(size + sizeof(LuaBlockHeader));
+    if (!block) {
+      return nullptr;
+    }
+    luaArena.heapBlocks++;
+    luaArena.heapUsed += size + sizeof(LuaBlockHeader);
+  }
+
+  block->size = size;
+  block->owner = owner;
+  luaArena.usage[owner] += blockFootprint(block);
+  return block;
+}
+
+static void blockFree(LuaBlockHeader * block)
+{
+  uint32_t footprint = blockFootprint(block);
+  luaArena.usage[block->owner] -= footprint;
+
+  if (isArenaBlock(block)) {
+    LuaFreeBlock * item = (LuaFreeBlock *)block;
+    unsigned cls = blockClass(block->size);
+    item->next = luaArena.freeList[cls];
+    luaArena.freeList[cls] = item;
+    luaArena.poolsFree += footprint;
+    if (--luaArena.arenaBlocks == 0) {
+      // all Lua states closed, the pools may be sized differently next time
+      arenaReset();
+    }
+  }
+  else {
+    luaArena.heapBlocks--;
+    luaArena.heapUsed -= footprint;
+    free(block);
+  }
+}
+
+void * luaArenaAlloc(void * ud, void * ptr, size_t osize, size_t nsize)
+{
+  UNUSED(osize);  // we have our own copy in the block header
+
+  if (nsize == 0) {
+    if (ptr) {
+      blockFree((LuaBlockHeader *)ptr - 1);
+    }
+    return nullptr;
+  }
+
+  if (!ptr) {
+    LuaBlockHeader * block = blockMalloc(nsize, ud ? *(uint8_t *)ud : luaArenaOwner);
+    return block ? block + 1 : nullptr;
+  }
+
+  LuaBlockHeader * block = (LuaBlockHeader *)ptr - 1;
+  unsigned cls = blockClass(nsize);
+
+  if (isArenaBlock(block)) {
+    if (cls == blockClass(block->size)) {
+      // same pool, the footprint doesn't change
+      block->size = nsize;
+      return ptr;
+    }
+  }
+  else if (cls == LUA_ARENA_CLASSES) {
+    // big block staying big, let the heap handle it
+    uint8_t owner = block->owner;
+    uint32_t footprint = blockFootprint(block);
+    LuaBlockHeader * result = (LuaBlockHeader *)realloc(block, nsize + sizeof(LuaBlockHeader));
+    if (!result) {
+      return nullptr;
+    }
+    result->size = nsize;
+    luaArena.usage[owner] += blockFootprint(result) - footprint;
+    luaArena.heapUsed += blockFootprint(result) - footprint;
+    return result + 1;
+  }
+
+  LuaBlockHeader * result = blockMalloc(nsize, block->owner);
+  if (!result) {
+    // Lua expects a block to be shrunk in any case
+    return nsize < block->size ? ptr : nullptr;
+  }
+  memcpy(result + 1, ptr, min<size_t>(block->size, nsize));
+  blockFree(block);
+  return result + 1;
+}
+
+void luaArenaSetOwner(uint8_t owner)
+{
+  luaArenaOwner = owner;
+}
+
+uint8_t luaArenaGetOwner()
+{
+  return luaArenaOwner;
+}
+
+uint32_t luaArenaGetUsage(uint8_t owner)
+{
+  return owner < LUA_ARENA_OWNERS ? luaArena.usage[owner] : 0;
+}
+
+void luaArenaGetStats(LuaArenaStats & stats)
+{
+  stats.arenaSize = sizeof(luaArenaData);
+  stats.arenaUsed = luaArena.top ? luaArena.top - arenaStart() : 0;
+  stats.poolsFree = luaArena.poolsFree;
+  stats.heapUsed = luaArena.heapUsed;
+  stats.blocks = luaArena.arenaBlocks + luaArena.heapBlocks;
+}
+
+#endif // #if defined(LUA_ARENA_SIZE)
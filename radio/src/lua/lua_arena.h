@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _LUA_ARENA_H_
+#define _LUA_ARENA_H_
+
+#include <inttypes.h>
+#include <stddef.h>
+#include "dataconstants.h"
+
+// Owners of the Lua allocations, the first ones are the script slots
+#define LUA_ARENA_OWNER_WIDGETS        (MAX_SCRIPTS)
+#define LUA_ARENA_OWNER_SYSTEM         (MAX_SCRIPTS + 1)
+#define LUA_ARENA_OWNERS               (MAX_SCRIPTS + 2)
+
+#if defined(LUA_ARENA_SIZE)
+
+struct LuaArenaStats {
+  uint32_t arenaSize;    // total size of the arena
+  uint32_t arenaUsed;    // bytes given to the size class pools
+  uint32_t poolsFree;    // bytes available in the pools free lists
+  uint32_t heapUsed;     // bytes of the big blocks allocated from the heap
+  uint32_t blocks;       // number of live blocks
+};
+
+/*
+  Lua allocator: small blocks come from size class pools carved out of a
+  dedicated arena, the big ones from the heap. Each block is tagged with its
+  owner so the memory can be accounted per script.
+  ud is either nullptr (blocks are owned by the current owner) or points to
+  a fixed owner for the whole Lua state.
+*/
+void * luaArenaAlloc(void * ud, void * ptr, size_t osize, size_t nsize);
+
+void luaArenaSetOwner(uint8_t owner);
+uint8_t luaArenaGetOwner();
+uint32_t luaArenaGetUsage(uint8_t owner);
+void luaArenaGetStats(LuaArenaStats & stats);
+
+#else
+
+inline void luaArenaSetOwner(uint8_t) {}
+inline uint8_t luaArenaGetOwner() { return LUA_ARENA_OWNER_SYSTEM; }
+inline uint32_t luaArenaGetUsage(uint8_t) { return 0; }
+
+#endif // #if defined(LUA_ARENA_SIZE)
+
+#endif // _LUA_ARENA_H_
@@ -32,6 +32,7 @@
 #define MANUAL_SCRIPTS_MAX_INSTRUCTIONS    (20000/100)
 #define LUA_WARNING_INFO_LEN               64
 #define EVENT_BUFFER_SIZE                   2
+#define MAX_WIDGET_SOURCES                  8
 
 #if defined(HARDWARE_TOUCH)
 #include "touch.h"
@@ -41,6 +42,7 @@
 #endif
 
 constexpr int LUA_WIDGET_REFRESH = 1000 / 10; // 10 Hz
+constexpr int LUA_WIDGET_IDLE_REFRESH_MAX = 1000; // 1 Hz, for unchanged retained widgets
 
 lua_State * lsWidgets = NULL;
 
@@ -242,6 +244,7 @@ class LuaWidget: public Widget
     {
       luaL_unref(lsWidgets, LUA_REGISTRYINDEX, luaWidgetDataRef);
       free(errorMessage);
+      delete cache;
     }
 
 #if defined(DEBUG_WINDOWS)
@@ -274,6 +277,14 @@ class LuaWidget: public Widget
     char * errorMessage;
     uint32_t lastRefresh = 0;
     bool     refreshed = false;
+    bool     hidden = false;
+
+    // Retained mode (widget declares its 'sources')
+    BitmapBuffer * cache = nullptr;
+    bool     cacheValid = false;
+    uint32_t sourcesHash = 0;
+    uint32_t lastLuaRefresh = 0;
+    uint32_t idlePeriod = LUA_WIDGET_REFRESH;
 
     static eventData events[EVENT_BUFFER_SIZE];
 #if defined(HARDWARE_TOUCH)
@@ -283,6 +294,12 @@ class LuaWidget: public Widget
 
     void checkEvents() override;
     void setErrorMessage(const char * funcName);
+
+    bool isRetained() const;
+    uint32_t getSourcesHash() const;
+    bool isLuaRefreshNeeded(uint32_t now);
+    bool drawCache(BitmapBuffer * dc);
+    void saveCache(BitmapBuffer * dc);
   
   private:
     eventData* findOpenEventSlot(event_t event = 0);
@@ -320,7 +337,9 @@ class LuaWidgetFactory: public WidgetFactory
       createFunction(createFunction),
       updateFunction(0),
       refreshFunction(0),
-      backgroundFunction(0)
+      backgroundFunction(0),
+      retained(false),
+      sourcesCount(0)
     {
     }
 
@@ -376,6 +395,12 @@ class LuaWidgetFactory: public WidgetFactory
     int updateFunction;
     int refreshFunction;
     int backgroundFunction;
+
+    // set when the widget declares 'sources': refresh() is then only
+    // called when one of them changes, otherwise the last output is reused
+    bool retained;
+    uint8_t sourcesCount;
+    mixsrc_t sources[MAX_WIDGET_SOURCES];
 };
 
 // Look for a slot in the event buffer that is either unused (zero) or matches event
@@ -397,11 +422,19 @@ void LuaWidget::checkEvents()
   if (!refreshed) {
     background();
     refreshed = true;
+    hidden = true;
   }
   
   uint32_t now = RTOS_GET_MS();
   if (now - lastRefresh >= LUA_WIDGET_REFRESH) {
     lastRefresh = now;
+
+    if (isRetained() && !hidden && cacheValid && !isLuaRefreshNeeded(now)) {
+      // nothing changed since the last refresh()
+      return;
+    }
+
+    cacheValid = false;
     refreshed = false;
     invalidate();
 
@@ -411,6 +444,73 @@ void LuaWidget::checkEvents()
   }
 }
 
+bool LuaWidget::isRetained() const
+{
+  return ((LuaWidgetFactory *)factory)->retained && !fullscreen && !errorMessage;
+}
+
+uint32_t LuaWidget::getSourcesHash() const
+{
+  LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
+  getvalue_t values[MAX_WIDGET_SOURCES];
+  for (uint8_t i = 0; i < factory->sourcesCount; i++) {
+    values[i] = getValue(factory->sources[i]);
+  }
+  return hash(values, factory->sourcesCount * sizeof(getvalue_t));
+}
+
+bool LuaWidget::isLuaRefreshNeeded(uint32_t now)
+{
+  uint32_t newHash = getSourcesHash();
+  if (newHash != sourcesHash) {
+    sourcesHash = newHash;
+    idlePeriod = LUA_WIDGET_REFRESH;
+    return true;
+  }
+
+  // values not covered by the sources (time, ...) still need a refresh
+  // from time to time, at a rate which slows down while nothing changes
+  return now - lastLuaRefresh >= idlePeriod;
+}
+
+bool LuaWidget::drawCache(BitmapBuffer * dc)
+{
+  if (!cacheValid || !cache || cache->width() != width() || cache->height() != height())
+    return false;
+
+  dc->drawBitmap(0, 0, cache);
+  return true;
+}
+
+void LuaWidget::saveCache(BitmapBuffer * dc)
+{
+  cacheValid = false;
+
+  // the widget output can only be captured if it is entirely drawn
+  coord_t x = dc->getOffsetX();
+  coord_t y = dc->getOffsetY();
+  coord_t xmin, xmax, ymin, ymax;
+  dc->getClippingRect(xmin, xmax, ymin, ymax);
+  if (x < xmin || y < ymin || x + width() > xmax || y + height() > ymax)
+    return;
+
+  if (!cache || cache->width() != width() || cache->height() != height()) {
+    delete cache;
+    cache = new BitmapBuffer(BMP_RGB565, width(), height());
+    if (!cache || !cache->getData()) {
+      // not enough memory, stay in immediate mode
+      delete cache;
+      cache = nullptr;
+      return;
+    }
+  }
+
+  for (coord_t line = 0; line < height(); line++) {
+    memcpy(cache->getPixelPtr(0, line), dc->getPixelPtr(x, y + line), width() * sizeof(pixel_t));
+  }
+  cacheValid = true;
+}
+
 void LuaWidget::update()
 {
   Widget::update();
@@ -443,6 +543,10 @@ void LuaWidget::update()
   if (lua_pcall(lsWidgets, 2, 0, 0) != 0) {
     setErrorMessage("update()");
   }
+
+  // options have changed: force the next refresh
+  cacheValid = false;
+  idlePeriod = LUA_WIDGET_REFRESH;
 }
 
 void LuaWidget::setErrorMessage(const char * funcName)
@@ -466,11 +570,24 @@ void LuaWidget::refresh(BitmapBuffer* dc)
 {
   if (lsWidgets == 0) return;
 
+  hidden = false;
+
   if (errorMessage) {
     drawTextLines(dc, 0, 0, fullscreen ? LCD_W : rect.w, fullscreen ? LCD_H : rect.h, errorMessage, FONT(XS) | COLOR_THEME_WARNING);
     return;
   }
 
+  bool retained = isRetained();
+  if (retained) {
+    if (drawCache(dc)) {
+      refreshed = true;
+      return;
+    }
+  }
+  else {
+    cacheValid = false;
+  }
+
   luaSetInstructionsLimit(lsWidgets, WIDGET_SCRIPTS_MAX_INSTRUCTIONS);
   LuaWidgetFactory * factory = (LuaWidgetFactory *)this->factory;
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, factory->refreshFunction);
@@ -536,14 +653,29 @@ void LuaWidget::refresh(BitmapBuffer* dc)
   luaLcdAllowed = true;
   runningFS = this;
 
-  if (lua_pcall(lsWidgets, 3, 0, 0) != 0) {
+  bool unchanged = false;
+  if (lua_pcall(lsWidgets, 3, 1, 0) != 0) {
     setErrorMessage("refresh()");
   }
+  else {
+    // refresh() may return false to report that nothing has changed
+    unchanged = lua_isboolean(lsWidgets, -1) && !lua_toboolean(lsWidgets, -1);
+  }
+  lua_pop(lsWidgets, 1);
   runningFS = nullptr;
   // Remove LCD
   luaLcdAllowed = lla;
   luaLcdBuffer = nullptr;
 
+  if (retained && !errorMessage) {
+    lastLuaRefresh = RTOS_GET_MS();
+    if (unchanged)
+      idlePeriod = min<uint32_t>(idlePeriod * 2, LUA_WIDGET_IDLE_REFRESH_MAX);
+    else
+      idlePeriod = LUA_WIDGET_REFRESH;
+    saveCache(dc);
+  }
+
   // mark as refreshed
   refreshed = true;
 }
@@ -663,6 +795,9 @@ void luaLoadWidgetCallback()
   TRACE("luaLoadWidgetCallback()");
   const char * name=NULL;
   int widgetOptions=0, createFunction=0, updateFunction=0, refreshFunction=0, backgroundFunction=0;
+  bool retained = false;
+  uint8_t sourcesCount = 0;
+  mixsrc_t sources[MAX_WIDGET_SOURCES];
 
   luaL_checktype(lsWidgets, -1, LUA_TTABLE);
 
@@ -691,6 +826,25 @@ void luaLoadWidgetCallback()
       backgroundFunction = luaL_ref(lsWidgets, LUA_REGISTRYINDEX);
       lua_pushnil(lsWidgets);
     }
+    else if (!strcmp(key, "sources")) {
+      luaL_checktype(lsWidgets, -1, LUA_TTABLE);
+      retained = true;
+      for (lua_pushnil(lsWidgets); lua_next(lsWidgets, -2); lua_pop(lsWidgets, 1)) {
+        if (sourcesCount >= MAX_WIDGET_SOURCES) {
+          TRACE("widget %s: too many sources", name ? name : "");
+          continue;
+        }
+        if (lua_type(lsWidgets, -1) == LUA_TNUMBER) {
+          sources[sourcesCount++] = lua_tointeger(lsWidgets, -1);
+        }
+        else {
+          LuaField field;
+          if (luaFindFieldByName(luaL_checkstring(lsWidgets, -1), field)) {
+            sources[sourcesCount++] = field.id;
+          }
+        }
+      }
+    }
   }
 
   if (name && createFunction) {
@@ -700,6 +854,9 @@ void luaLoadWidgetCallback()
       factory->updateFunction = updateFunction;
       factory->refreshFunction = refreshFunction;
       factory->backgroundFunction = backgroundFunction;   // NOSONAR
+      factory->retained = retained;
+      factory->sourcesCount = sourcesCount;
+      memcpy(factory->sources, sources, sourcesCount * sizeof(mixsrc_t));
       TRACE("Loaded Lua widget %s", name);
     }
   }
@@ -781,6 +938,9 @@ void luaInitThemesAndWidgets()
   memclear(&lsWidgetsTrace, sizeof(lsWidgetsTrace));
   lsWidgetsTrace.script = "lua_newstate(widgets)";
   lsWidgets = lua_newstate(tracer_alloc, &lsWidgetsTrace);   //we use tracer allocator
+#elif defined(LUA_ARENA_SIZE)
+  static uint8_t lsWidgetsOwner = LUA_ARENA_OWNER_WIDGETS;
+  lsWidgets = lua_newstate(luaArenaAlloc, &lsWidgetsOwner);   //we use the arena, all blocks owned by the widgets
 #else
   lsWidgets = lua_newstate(l_alloc, NULL);   //we use Lua default allocator
 #endif
@@ -24,6 +24,7 @@
 
 #if defined(LIBOPENUI)
   #include "libopenui.h"
+  #include "gui/colorlcd/fonts.h"
 #endif
 
 uint8_t currentSpeakerVolume = 255;
@@ -277,6 +278,24 @@ void checkEeprom()
 }
 #endif
 
+// The menus task runs early on user input (menusTaskWakeup()), these jobs
+// keep the period of its 50ms loop. The check is 10ms short, the loop is
+// timed from its start, not from the point where the job runs
+#define STORAGE_JOB_PERIOD_MS          50
+#define LOGS_JOB_PERIOD_MS             50
+#define LUA_BACKGROUND_JOB_PERIOD_MS   50
+#define JOB_PERIOD_JITTER_MS           10
+
+static bool isJobDue(uint32_t & lastRun, uint32_t period)
+{
+  uint32_t now = RTOS_GET_MS();
+  if (now - lastRun < period - JOB_PERIOD_JITTER_MS) {
+    return false;
+  }
+  lastRun = now;
+  return true;
+}
+
 #define BAT_AVG_SAMPLES       8
 
 void checkBatteryAlarms()
@@ -347,36 +366,41 @@ void guiMain(event_t evt)
 {
 
 #if defined(LUA)
-  uint32_t t0 = get_tmr10ms();
-  static uint32_t lastLuaTime = 0;
-  uint16_t interval = (lastLuaTime == 0 ? 0 : (t0 - lastLuaTime));
-  lastLuaTime = t0;
-  if (interval > maxLuaInterval) {
-    maxLuaInterval = interval;
-  }
+  static uint32_t luaJobTime = 0;
+  if (isJobDue(luaJobTime, LUA_BACKGROUND_JOB_PERIOD_MS)) {
+    uint32_t t0 = get_tmr10ms();
+    static uint32_t lastLuaTime = 0;
+    uint16_t interval = (lastLuaTime == 0 ? 0 : (t0 - lastLuaTime));
+    lastLuaTime = t0;
+    if (interval > maxLuaInterval) {
+      maxLuaInterval = interval;
+    }
 
-  DEBUG_TIMER_START(debugTimerLua);
+    DEBUG_TIMER_START(debugTimerLua);
 
-  // Run Lua scripts first that don't use LCD
-  luaTask(  0, false);
+    // Run Lua scripts first that don't use LCD
+    luaTask(  0, false);
 
-  // This is run from StandaloneLuaWindow::checkEvents()
-  // luaTask(evt, RUN_STNDAL_SCRIPT, true);
+    // This is run from StandaloneLuaWindow::checkEvents()
+    // luaTask(evt, RUN_STNDAL_SCRIPT, true);
 
-  // TODO: Telemetry scripts are run from Window::checkEvents()
-  // luaTask(  0, RUN_TELEM_BG_SCRIPT, false/* NO LCD */);
-  // luaTask(evt, RUN_TELEM_FG_SCRIPT, true/* LCD YES */);
-  DEBUG_TIMER_STOP(debugTimerLua);
+    // TODO: Telemetry scripts are run from Window::checkEvents()
+    // luaTask(  0, RUN_TELEM_BG_SCRIPT, false/* NO LCD */);
+    // luaTask(evt, RUN_TELEM_FG_SCRIPT, true/* LCD YES */);
+    DEBUG_TIMER_STOP(debugTimerLua);
 
-  t0 = get_tmr10ms() - t0;
-  if (t0 > maxLuaDuration) {
-    maxLuaDuration = t0;
+    t0 = get_tmr10ms() - t0;
+    if (t0 > maxLuaDuration) {
+      maxLuaDuration = t0;
+    }
   }
 #endif
 #if defined(HARDWARE_TOUCH)
   MainWindow* mainWin = MainWindow::instance();
   mainWin->setTouchEnabled(!isFunctionActive(FUNCTION_DISABLE_TOUCH) && isBacklightEnabled());
 #endif
+  // only the standard font is loaded at boot, the windows may use them all
+  loadAllFonts();
   MainWindow::instance()->run();
 
   bool screenshotRequested = (mainRequestFlags & (1u << REQUEST_SCREENSHOT));
@@ -410,21 +434,24 @@ void guiMain(event_t evt)
 {
   bool refreshNeeded = menuEvent || warningText || (popupMenuItemsCount > 0);
 #if defined(LUA)
-  // TODO better lua stopwatch
-  uint32_t t0 = get_tmr10ms();
-  static uint32_t lastLuaTime = 0;
-  uint16_t interval = (lastLuaTime == 0 ? 0 : (t0 - lastLuaTime));
-  lastLuaTime = t0;
-  if (interval > maxLuaInterval) {
-    maxLuaInterval = interval;
-  }
+  static uint32_t luaJobTime = 0;
+  if (isJobDue(luaJobTime, LUA_BACKGROUND_JOB_PERIOD_MS)) {
+    // TODO better lua stopwatch
+    uint32_t t0 = get_tmr10ms();
+    static uint32_t lastLuaTime = 0;
+    uint16_t interval = (lastLuaTime == 0 ? 0 : (t0 - lastLuaTime));
+    lastLuaTime = t0;
+    if (interval > maxLuaInterval) {
+      maxLuaInterval = interval;
+    }
 
-  // run Lua scripts that don't use LCD (to use CPU time while LCD DMA is running)
-  luaTask(0, false);
+    // run Lua scripts that don't use LCD (to use CPU time while LCD DMA is running)
+    luaTask(0, false);
 
-  t0 = get_tmr10ms() - t0;
-  if (t0 > maxLuaDuration) {
-    maxLuaDuration = t0;
+    t0 = get_tmr10ms() - t0;
+    if (t0 > maxLuaDuration) {
+      maxLuaDuration = t0;
+    }
   }
 #endif //#if defined(LUA)
 
@@ -487,8 +514,14 @@ void perMain()
   checkSpeakerVolume();
 
   if (!usbPlugged() || (getSelectedUsbMode() == USB_UNSELECTED_MODE)) {
-    checkEeprom();
-    logsWrite();
+    static uint32_t storageJobTime = 0;
+    if (isJobDue(storageJobTime, STORAGE_JOB_PERIOD_MS)) {
+      checkEeprom();
+    }
+    static uint32_t logsJobTime = 0;
+    if (isJobDue(logsJobTime, LOGS_JOB_PERIOD_MS)) {
+      logsWrite();
+    }
   }
 
   handleUsbConnection();
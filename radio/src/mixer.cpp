@@ -215,24 +215,48 @@ void applyExpos(int16_t * anas, uint8_t mode, uint8_t ovwrIdx, int16_t ovwrValue
 // a bulletproof implementation would take about additional 100bytes flash
 // therefore with go with this compromize, interested people could activate this define
 
-// @@@2 open.20.fsguruh ;
-// channel = channelnumber -1;
-// value = outputvalue with 100 mulitplied usual range -102400 to 102400; output -1024 to 1024
-// changed rescaling from *100 to *256 to optimize performance
-// rescaled from -262144 to 262144
-int16_t applyLimits(uint8_t channel, int32_t value)
+// Limits of a set of channels, stored as one array per field, so that the
+// arithmetic part runs as a single branch free pass over all channels once the
+// model data (GVars, output curves) has been gathered
+template <unsigned int N>
+struct LimitsBatch {
+  int32_t value[N];
+  int16_t ofs[N];
+  int16_t scalePos[N];   // applied to positive values
+  int16_t scaleNeg[N];   // applied to negative values
+  int16_t min[N];
+  int16_t max[N];
+  int16_t sign[N];       // -1 when the channel is reverted
+  int16_t output[N];
+};
+
+// override and trainer channels bypass the limits
+static inline bool getFixedOutput(uint8_t channel, bool trainerChannels, int16_t & output)
 {
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
   if (safetyCh[channel] != OVERRIDE_CHANNEL_UNDEFINED) {
     // safety channel available for channel check
-    return calc100toRESX(safetyCh[channel]);
+    output = calc100toRESX(safetyCh[channel]);
+    return true;
   }
 #endif
 
-  if (isFunctionActive(FUNCTION_TRAINER_CHANNELS) && IS_TRAINER_INPUT_VALID()) {
-    return ppmInput[channel] * 2;
+  if (trainerChannels) {
+    output = ppmInput[channel] * 2;
+    return true;
   }
 
+  return false;
+}
+
+// @@@2 open.20.fsguruh ;
+// channel = channelnumber -1;
+// value = outputvalue with 100 mulitplied usual range -102400 to 102400; output -1024 to 1024
+// changed rescaling from *100 to *256 to optimize performance
+// rescaled from -262144 to 262144
+template <unsigned int N>
+static void loadLimits(LimitsBatch<N> & batch, uint8_t index, uint8_t channel, int32_t value)
+{
   LimitData * lim = limitAddress(channel);
 
   if (lim->curve) {
@@ -250,50 +274,61 @@ int16_t applyLimits(uint8_t channel, int32_t value)
   if (ofs > lim_p) ofs = lim_p;
   if (ofs < lim_n) ofs = lim_n;
 
-  // because the rescaling optimization would reduce the calculation reserve we activate this for all builds
-  // it increases the calculation reserve from factor 20,25x to 32x, which it slightly better as original
-  // without it we would only have 16x which is slightly worse as original, we should not do this
-
-  // thanks to gbirkus, he motivated this change, which greatly reduces overruns
-  // unfortunately the constants and 32bit compares generates about 50 bytes codes; didn't find a way to get it down.
-  value = limit(int32_t(-RESXl*256), value, int32_t(RESXl*256));  // saves 2 bytes compared to other solutions up to now
-
+  batch.value[index] = value;
+  batch.ofs[index] = ofs;
 #if defined(PPM_LIMITS_SYMETRICAL)
-  if (value) {
-    int16_t tmp;
-    if (lim->symetrical)
-      tmp = (value > 0) ? (lim_p) : (-lim_n);
-    else
-      tmp = (value > 0) ? (lim_p - ofs) : (-lim_n + ofs);
-    value = (int32_t) value * tmp;   //  div by 1024*256 -> output = -1024..1024
-#else
-  if (value) {
-    int16_t tmp = (value > 0) ? (lim_p - ofs) : (-lim_n + ofs);
-    value = (int32_t) value * tmp;   //  div by 1024*256 -> output = -1024..1024
+  if (lim->symetrical) {
+    batch.scalePos[index] = lim_p;
+    batch.scaleNeg[index] = -lim_n;
+  }
+  else
 #endif
+  {
+    batch.scalePos[index] = lim_p - ofs;
+    batch.scaleNeg[index] = -lim_n + ofs;
+  }
+  batch.min[index] = lim_n;
+  batch.max[index] = lim_p;
+  batch.sign[index] = lim->revert ? -1 : 1;
+}
+
+template <unsigned int N>
+static void computeLimits(LimitsBatch<N> & batch)
+{
+  for (unsigned int i = 0; i < N; i++) {
+    // because the rescaling optimization would reduce the calculation reserve we activate this for all builds
+    // it increases the calculation reserve from factor 20,25x to 32x, which it slightly better as original
+    // without it we would only have 16x which is slightly worse as original, we should not do this
+
+    // thanks to gbirkus, he motivated this change, which greatly reduces overruns
+    int32_t value = limit(int32_t(-RESXl*256), batch.value[i], int32_t(RESXl*256));
+
+    // a null value gives a null product, no need to test it
+    value *= (value > 0 ? batch.scalePos[i] : batch.scaleNeg[i]);   //  div by 1024*256 -> output = -1024..1024
 
 #ifdef CORRECT_NEGATIVE_SHIFTS
-    int8_t sign = (value<0?1:0);
-    value -= sign;
-    tmp = value>>16;   // that's quite tricky: the shiftright 16 operation is assmbled just with addressmove; just forget the two least significant bytes;
-    tmp >>= 2;   // now one simple shift right for two bytes does the rest
-    tmp += sign;
+    int32_t sign = (value < 0 ? 1 : 0);
+    int32_t ofs = batch.ofs[i] + ((value - sign) >> 18) + sign;
 #else
-    tmp = value>>16;   // that's quite tricky: the shiftright 16 operation is assmbled just with addressmove; just forget the two least significant bytes;
-    tmp >>= 2;   // now one simple shift right for two bytes does the rest
+    int32_t ofs = batch.ofs[i] + (value >> 18);   // ofs can to added directly because already recalculated
 #endif
 
-    ofs += tmp;  // ofs can to added directly because already recalculated,
+    ofs = limit<int32_t>(batch.min[i], ofs, batch.max[i]);
+    batch.output[i] = ofs * batch.sign[i];   // finally do the reverse
   }
+}
 
-  if (ofs > lim_p)
-    ofs = lim_p;
-  if (ofs < lim_n)
-    ofs = lim_n;
-  if (lim->revert)
-    ofs = -ofs; // finally do the reverse.
+int16_t applyLimits(uint8_t channel, int32_t value)
+{
+  int16_t output;
+  if (getFixedOutput(channel, isFunctionActive(FUNCTION_TRAINER_CHANNELS) && IS_TRAINER_INPUT_VALID(), output)) {
+    return output;
+  }
 
-  return ofs;
+  LimitsBatch<1> batch;
+  loadLimits(batch, 0, channel, value);
+  computeLimits(batch);
+  return batch.output[0];
 }
 
 // TODO same naming convention than the drawSource
@@ -383,7 +418,7 @@ getvalue_t getValue(mixsrc_t i)
 
   else if (i <= MIXSRC_LAST_GVAR) {
 #if defined(GVARS)
-    return GVAR_VALUE(i - MIXSRC_GVAR1, getGVarFlightMode(mixerCurrentFlightMode, i - MIXSRC_GVAR1));
+    return getGVarValue(i - MIXSRC_GVAR1, mixerCurrentFlightMode);
 #else
     return 0;
 #endif
@@ -951,6 +986,12 @@ void evalMixes(uint8_t tick10ms)
     }
   }
 
+#if defined(GVARS)
+  // GVar values of all the flight modes resolved once, the passes below
+  // read them from a flat table
+  updateGVarCache();
+#endif
+
   int32_t weight = 0;
   if (flightModesFade) {
     memclear(sum_chans512, sizeof(sum_chans512));
@@ -965,6 +1006,11 @@ void evalMixes(uint8_t tick10ms)
     }
     assert(weight);
     mixerCurrentFlightMode = fm;
+
+    // weighted average of the flight modes, as one pass over all channels
+    for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+      sum_chans512[i] = (sum_chans512[i] / weight) << 4;
+    }
   }
   else {
     mixerCurrentFlightMode = fm;
@@ -985,19 +1031,32 @@ void evalMixes(uint8_t tick10ms)
   }
 
   //========== LIMITS ===============
+  static LimitsBatch<MAX_OUTPUT_CHANNELS> limits;  // too large for the mixer stack
+  int16_t fixedOutputs[MAX_OUTPUT_CHANNELS];
+  uint32_t fixedChannels = 0;
+  bool trainerChannels = isFunctionActive(FUNCTION_TRAINER_CHANNELS) && IS_TRAINER_INPUT_VALID();
+  const int32_t * mixed = (flightModesFade ? sum_chans512 : chans);
+
   for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
     // chans[i] holds data from mixer.   chans[i] = v*weight => 1024*256
     // later we multiply by the limit (up to 100) and then we need to normalize
     // at the end chans[i] = chans[i]/256 =>  -1024..1024
     // interpolate value with min/max so we get smooth motion from center to stop
     // this limits based on v original values and min=-1024, max=1024  RESX=1024
-    int32_t q = (flightModesFade ? (sum_chans512[i] / weight) << 4 : chans[i]);
+    int32_t q = mixed[i];
 
     ex_chans[i] = q / 256;
 
-    int16_t value = applyLimits(i, q);  // applyLimits will remove the 256 100% basis
+    if (getFixedOutput(i, trainerChannels, fixedOutputs[i]))
+      fixedChannels |= (1u << i);
+    else
+      loadLimits(limits, i, i, q);
+  }
 
-    channelOutputs[i] = value;  // copy consistent word to int-level
+  computeLimits(limits);  // removes the 256 100% basis
+
+  for (uint8_t i=0; i<MAX_OUTPUT_CHANNELS; i++) {
+    channelOutputs[i] = (fixedChannels & (1u << i)) ? fixedOutputs[i] : limits.output[i];  // copy consistent word to int-level
   }
 
   if (tick10ms && flightModesFade) {
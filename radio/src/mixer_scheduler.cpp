@@ -31,22 +31,44 @@ struct MixerSchedule {
 
   // period in us
   volatile uint16_t period;
+
+  // time left before the next frame in us (ISR)
+  int32_t countdown;
+
+  // time since the last heartbeat in us (ISR)
+  int32_t sinceHeartbeat;
+
+  // frames paced by the module heartbeat instead of the timer
+  bool heartbeat;
 };
 
 static MixerSchedule mixerSchedules[NUM_MODULES];
 
-uint16_t getMixerSchedulerPeriod()
+// modules whose frame is due
+static volatile uint8_t mixerSchedulerDueModules;
+
+// The module with the shortest period paces the timer, the internal
+// module on ties. The other one gets its frame on the tick closest to
+// its own deadline, instead of having its frame built on every tick or
+// holding back the faster module
+static int getMixerSchedulerMaster()
 {
-#if defined(HARDWARE_INTERNAL_MODULE)
-  if (mixerSchedules[INTERNAL_MODULE].period) {
-    return mixerSchedules[INTERNAL_MODULE].period;
+  int master = -1;
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    uint16_t period = mixerSchedules[i].period;
+    if (period && (master < 0 || period < mixerSchedules[master].period)) {
+      master = i;
+    }
   }
-#endif
-#if defined(HARDWARE_EXTERNAL_MODULE)
-  if (mixerSchedules[EXTERNAL_MODULE].period) {
-    return mixerSchedules[EXTERNAL_MODULE].period;
+  return master;
+}
+
+uint16_t getMixerSchedulerPeriod()
+{
+  int master = getMixerSchedulerMaster();
+  if (master >= 0) {
+    return mixerSchedules[master].period;
   }
-#endif
 #if defined(STM32) && !defined(SIMU)
   if (getSelectedUsbMode() == USB_JOYSTICK_MODE) {
     return MIXER_SCHEDULER_JOYSTICK_PERIOD_US;
@@ -72,6 +94,94 @@ void mixerSchedulerSetPeriod(uint8_t moduleIdx, uint16_t periodUs)
   mixerSchedules[moduleIdx].period = periodUs;
 }
 
+// Advance the module countdowns by the time elapsed since the last
+// trigger, returns the modules whose frame is due on this trigger
+static uint8_t mixerSchedulerAdvance(uint16_t elapsedUs, bool timerTick)
+{
+  int master = getMixerSchedulerMaster();
+  int32_t halfTick = getMixerSchedulerPeriod() / 2;
+  uint8_t due = 0;
+
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    MixerSchedule & schedule = mixerSchedules[i];
+    if (!schedule.period) {
+      continue;
+    }
+
+    if (schedule.heartbeat) {
+      schedule.sinceHeartbeat += elapsedUs;
+      if (schedule.sinceHeartbeat <= 2 * schedule.period) {
+        // the timer only backs up a late heartbeat of the module pacing it
+        if (timerTick && i == master) {
+          due |= 1 << i;
+        }
+        continue;
+      }
+      // heartbeat lost, back on the timer schedule
+      schedule.heartbeat = false;
+      schedule.countdown = 0;
+    }
+
+    schedule.countdown -= elapsedUs;
+    // the next trigger would be further from the deadline than this one
+    if (schedule.countdown <= halfTick) {
+      due |= 1 << i;
+      schedule.countdown += schedule.period;
+      if (schedule.countdown <= 0) {
+        schedule.countdown = schedule.period;
+      }
+    }
+  }
+
+  return due;
+}
+
+void mixerSchedulerTimerTick(uint16_t elapsedUs)
+{
+  mixerSchedulerDueModules |= mixerSchedulerAdvance(elapsedUs, true);
+}
+
+void mixerSchedulerModuleTrigger(uint8_t moduleIdx)
+{
+  // account for the time since the last trigger before the timer
+  // counter may be reset, the other modules keep their own deadlines
+  uint8_t due = mixerSchedulerAdvance(mixerSchedulerTimerElapsed(), false);
+  mixerSchedulerDueModules |= due | (1 << moduleIdx);
+
+  MixerSchedule & schedule = mixerSchedules[moduleIdx];
+  schedule.heartbeat = true;
+  schedule.sinceHeartbeat = 0;
+
+  // don't shift the ticks of a faster module
+  if (getMixerSchedulerMaster() == moduleIdx) {
+    mixerSchedulerResetTimer();
+  }
+
+  mixerSchedulerISRTrigger();
+}
+
+uint8_t mixerSchedulerGetRunMask()
+{
+  __disable_irq();
+  uint8_t due = mixerSchedulerDueModules;
+  mixerSchedulerDueModules = 0;
+  __enable_irq();
+
+  // modules without period run on every mixer iteration
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    if (!mixerSchedules[i].period) {
+      due |= 1 << i;
+    }
+  }
+
+  // woken up by the frequent actions timeout
+  if (!(due & ((1 << NUM_MODULES) - 1))) {
+    due = (1 << NUM_MODULES) - 1;
+  }
+
+  return due;
+}
+
 bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
 {
   uint32_t ulNotificationValue;
@@ -42,6 +42,9 @@ void mixerSchedulerStop();
 // Set the timer counter to 0
 void mixerSchedulerResetTimer();
 
+// Time elapsed since the last timer trigger, reset or call in us
+uint16_t mixerSchedulerTimerElapsed();
+
 // Set the scheduling period for a given module
 void mixerSchedulerSetPeriod(uint8_t moduleIdx, uint16_t periodUs);
 
@@ -63,6 +66,16 @@ uint16_t getMixerSchedulerPeriod();
 // Trigger mixer from an ISR
 void mixerSchedulerISRTrigger();
 
+// Account for the time elapsed since the last timer trigger (timer ISR)
+void mixerSchedulerTimerTick(uint16_t elapsedUs);
+
+// Trigger mixer for a module which paces itself (heartbeat ISR)
+void mixerSchedulerModuleTrigger(uint8_t moduleIdx);
+
+// Fetch and clear the modules whose frame is due,
+// all of them when the mixer was not run by the scheduler
+uint8_t mixerSchedulerGetRunMask();
+
 #else
 
 #define mixerSchedulerInit()
@@ -83,6 +96,7 @@ static inline bool mixerSchedulerWaitForTrigger(uint8_t timeout)
 
 #define getMixerSchedulerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 #define mixerSchedulerISRTrigger()
+#define mixerSchedulerGetRunMask() ((1 << NUM_MODULES) - 1)
 
 #endif
 
@@ -210,6 +210,10 @@ void per10ms()
   }
 #endif
 
+  if (s_evt) {
+    menusTaskWakeup();
+  }
+
   telemetryInterrupt10ms();
 
   // These moved here from evalFlightModeMixes() to improve beep trigger reliability.
@@ -60,6 +60,7 @@ void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size)
   }
 
   ppmInputValidityTimer = PPM_IN_VALID_TIMEOUT;
+  trainerFrameReceived();
 }
 
 void processSbusInput()
@@ -71,6 +72,12 @@ void processSbusInput()
   static uint16_t SbusTimer;
   static uint8_t SbusFrame[SBUS_FRAME_SIZE];
 
+#if defined(AUX_SERIAL_DMA_Stream_RX) || defined(AUX2_SERIAL_DMA_Stream_RX)
+  // decoded by the serial port IRQ on idle line
+  if (currentTrainerMode == TRAINER_MODE_MASTER_BATTERY_COMPARTMENT)
+    return;
+#endif
+
   while (sbusGetByte(&rxchar)) {
     active = 1;
     if (SbusIndex > SBUS_FRAME_SIZE-1) {
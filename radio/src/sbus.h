@@ -25,6 +25,7 @@
 #define SBUS_BAUDRATE         100000
 #define SBUS_FRAME_SIZE       25
 
+void processSbusFrame(uint8_t * sbus, int16_t * pulses, uint32_t size);
 void processSbusInput();
 
 #endif // _SBUS_H_
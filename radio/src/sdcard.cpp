@@ -212,20 +212,84 @@ const char * getBasename(const char * path)
   return path;
 }
 
+uint8_t sdFilterListedFile(const char * path, FILINFO & fno, const char * extension, const uint8_t maxlen, uint8_t flags)
+{
+  const char * fnExt;
+  uint8_t fnLen, extLen;
+  char tmpExt[LEN_FILE_EXTENSION_MAX+1] = "\0";
+
+  if (fno.fattrib & AM_DIR) return 0;            /* Skip subfolders */
+  if (fno.fattrib & AM_HID) return 0;            /* Skip hidden files */
+  if (fno.fattrib & AM_SYS) return 0;            /* Skip system files */
+
+  fnExt = getFileExtension(fno.fname, 0, 0, &fnLen, &extLen);
+  fnLen -= extLen;
+
+//  TRACE_DEBUG("listSdFiles(%s, %s, %u, %u): fn='%s'; fnExt='%s'; match=%d\n",
+//       path, extension, maxlen, flags, fno.fname, (fnExt ? fnExt : "nul"), (fnExt && isExtensionMatching(fnExt, extension)));
+  // file validation checks
+  if (!fnLen || fnLen > maxlen || (                                              // wrong size
+        fnExt && extension && (                                                  // extension-based checks follow...
+          !isExtensionMatching(fnExt, extension) || (                            // wrong extension
+            !(flags & LIST_SD_FILE_EXT) &&                                       // only if we want unique file names...
+            strcasecmp(fnExt, getFileExtension(extension)) &&                    // possible duplicate file name...
+            isFilePatternAvailable(path, fno.fname, extension, true, tmpExt) &&  // find the first file from extensions list...
+            strncasecmp(fnExt, tmpExt, LEN_FILE_EXTENSION_MAX)                   // found file doesn't match, this is a duplicate
+          )
+        )
+      ))
+  {
+    return 0;
+  }
+
+  if (!(flags & LIST_SD_FILE_EXT)) {
+    fno.fname[fnLen] = '\0';  // strip extension
+    return fnLen;
+  }
+
+  return fnLen + extLen;
+}
+
 #if !defined(LIBOPENUI)
+static uint8_t s_last_flags;
+
+static bool sdListCachedFiles(const DirectoryListing * listing, const uint8_t maxlen, const char * selection, uint8_t flags)
+{
+  uint16_t first = 0;
+  if (flags & LIST_NONE_SD_FILE) {
+    first = 1;
+  }
+
+  popupMenuItemsCount = first + listing->count();
+
+  if (selection) {
+    popupMenuOffset = first + listing->lowerBound(selection, maxlen);
+  }
+
+  for (uint8_t i=0; i<MENU_MAX_DISPLAY_LINES; i++) {
+    char * line = reusableBuffer.modelsel.menu_bss[i];
+    uint16_t index = popupMenuOffset + i;
+    memset(line, 0, MENU_LINE_LENGTH);
+    popupMenuItems[i] = line;
+    if (index >= popupMenuItemsCount)
+      break;
+    if (index < first)
+      strcpy(line, "---");
+    else
+      strncpy(line, listing->getName(index - first), MENU_LINE_LENGTH - 1);
+  }
+
+  return popupMenuItemsCount;
+}
+
 bool sdListFiles(const char * path, const char * extension, const uint8_t maxlen, const char * selection, uint8_t flags)
 {
   static uint16_t lastpopupMenuOffset = 0;
   FILINFO fno;
   DIR dir;
-  const char * fnExt;
-  uint8_t fnLen, extLen;
-  char tmpExt[LEN_FILE_EXTENSION_MAX+1] = "\0";
 
   popupMenuOffsetType = MENU_OFFSET_EXTERNAL;
 
-  static uint8_t s_last_flags;
-
   if (selection) {
     s_last_flags = flags;
     if (!isFilePatternAvailable(path, selection, ((flags & LIST_SD_FILE_EXT) ? nullptr : extension))) selection = nullptr;
@@ -234,6 +298,12 @@ bool sdListFiles(const char * path, const char * extension, const uint8_t maxlen
     flags = s_last_flags;
   }
 
+  const DirectoryListing * listing = dirCache.getListing(path, extension, maxlen, flags & LIST_SD_FILE_EXT);
+  if (listing) {
+    return sdListCachedFiles(listing, maxlen, selection, flags);
+  }
+
+  // the directory doesn't fit in the cache: scan it again for each page
   if (popupMenuOffset == 0) {
     lastpopupMenuOffset = 0;
     memset(reusableBuffer.modelsel.menu_bss, 0, sizeof(reusableBuffer.modelsel.menu_bss));
@@ -276,36 +346,10 @@ bool sdListFiles(const char * path, const char * extension, const uint8_t maxlen
     for (;;) {
       res = f_readdir(&dir, &fno);                   /* Read a directory item */
       if (res != FR_OK || fno.fname[0] == 0) break;  /* Break on error or end of dir */
-      if (fno.fattrib & AM_DIR) continue;            /* Skip subfolders */
-      if (fno.fattrib & AM_HID) continue;            /* Skip hidden files */
-      if (fno.fattrib & AM_SYS) continue;            /* Skip system files */
-
-      fnExt = getFileExtension(fno.fname, 0, 0, &fnLen, &extLen);
-      fnLen -= extLen;
-
-//      TRACE_DEBUG("listSdFiles(%s, %s, %u, %s, %u): fn='%s'; fnExt='%s'; match=%d\n",
-//           path, extension, maxlen, (selection ? selection : "nul"), flags, fno.fname, (fnExt ? fnExt : "nul"), (fnExt && isExtensionMatching(fnExt, extension)));
-      // file validation checks
-      if (!fnLen || fnLen > maxlen || (                                              // wrong size
-            fnExt && extension && (                                                  // extension-based checks follow...
-              !isExtensionMatching(fnExt, extension) || (                            // wrong extension
-                !(flags & LIST_SD_FILE_EXT) &&                                       // only if we want unique file names...
-                strcasecmp(fnExt, getFileExtension(extension)) &&                    // possible duplicate file name...
-                isFilePatternAvailable(path, fno.fname, extension, true, tmpExt) &&  // find the first file from extensions list...
-                strncasecmp(fnExt, tmpExt, LEN_FILE_EXTENSION_MAX)                   // found file doesn't match, this is a duplicate
-              )
-            )
-          ))
-      {
-        continue;
-      }
+      if (!sdFilterListedFile(path, fno, extension, maxlen, flags)) continue;
 
       popupMenuItemsCount++;
 
-      if (!(flags & LIST_SD_FILE_EXT)) {
-        fno.fname[fnLen] = '\0';  // strip extension
-      }
-
       if (popupMenuOffset == 0) {
         if (selection && strncasecmp(fno.fname, selection, maxlen) < 0) {
           lastpopupMenuOffset++;
@@ -395,6 +439,8 @@ const char * sdCopyFile(const char * srcPath, const char * destPath)
   f_close(&destFile);
   f_close(&srcFile);
 
+  dirCacheInvalidate();
+
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
@@ -28,6 +28,7 @@ extern FATFS g_FATFS_Obj;
 extern FIL g_oLogFile;
 
 #include "translations.h"
+#include "dir_cache.h"
 
 #define FILE_COPY_PREFIX "cp_"
 
@@ -178,6 +179,7 @@ const char * sdCopyFile(const char * srcFilename, const char * srcDir, const cha
 
 #define LIST_NONE_SD_FILE   1
 #define LIST_SD_FILE_EXT    2
+uint8_t sdFilterListedFile(const char * path, FILINFO & fno, const char * extension, const uint8_t maxlen, uint8_t flags);
 bool sdListFiles(const char * path, const char * extension, const uint8_t maxlen, const char * selection, uint8_t flags=0);
 
 #endif // _SDCARD_H_
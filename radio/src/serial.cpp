@@ -41,24 +41,40 @@ void serialPutc(char c) {
 #endif
 }
 
+void serialWrite(const char * data, uint32_t size)
+{
+#if !defined(BOOT) && defined(USB_SERIAL)
+  if (getSelectedUsbMode() == USB_SERIAL_MODE)
+    usbSerialWrite((const uint8_t *)data, size);
+#endif
+#if defined(AUX_SERIAL)
+  if (auxSerialTracesEnabled()) {
+    for (uint32_t i = 0; i < size; i++)
+      auxSerialPutc(data[i]);
+  }
+#endif
+#if defined(AUX2_SERIAL)
+  if (aux2SerialTracesEnabled()) {
+    for (uint32_t i = 0; i < size; i++)
+      aux2SerialPutc(data[i]);
+  }
+#endif
+}
+
 void serialPrintf(const char * format, ...)
 {
   va_list arglist;
   char tmp[PRINTF_BUFFER_SIZE+1];
 
   va_start(arglist, format);
-  vsnprintf(tmp, PRINTF_BUFFER_SIZE, format, arglist);
-  tmp[PRINTF_BUFFER_SIZE] = '\0';
+  int len = vsnprintf(tmp, PRINTF_BUFFER_SIZE, format, arglist);
   va_end(arglist);
 
-  const char *t = tmp;
-  while (*t) {
-    serialPutc(*t++);
-  }
+  if (len > 0)
+    serialWrite(tmp, min(len, PRINTF_BUFFER_SIZE - 1));
 }
 
 void serialCrlf()
 {
-  serialPutc('\r');
-  serialPutc('\n');
+  serialWrite("\r\n", 2);
 }
@@ -22,11 +22,14 @@
 #ifndef _SERIAL_H_
 #define _SERIAL_H_
 
+#include <inttypes.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 void serialPutc(char c);
+void serialWrite(const char * data, uint32_t size);
 void serialPrintf(const char *format, ...);
 void serialCrlf();
 
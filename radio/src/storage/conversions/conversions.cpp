@@ -29,12 +29,19 @@
 #include "storage/sdcard_yaml.h"
 #endif
 
+#if defined(COLORLCD)
+#include "gui/colorlcd/fonts.h"
+#endif
+
 #if defined(STORAGE_MODELSLIST)
 static void drawProgressScreen(const char* filename, int progress, int total)
 {
 #if defined(COLORLCD)
   OpenTxTheme* l_theme = static_cast<OpenTxTheme*>(theme);
 
+  // runs from the boot, only the standard font is loaded yet
+  loadFont(FONT_XL_INDEX);
+
   lcd->reset();
   l_theme->drawBackground(lcd);
   lcd->drawText(LCD_W/2, LCD_H/2 - 30, STR_CONVERTING, FONT(XL) | CENTERED | COLOR_THEME_WARNING);
@@ -465,6 +465,7 @@ const char * eeBackupModel(uint8_t i_fileSrc)
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
+  dirCacheInvalidate();
 
 #if defined(PCBSKY9X)
   strcpy(statusLineMsg, "File ");
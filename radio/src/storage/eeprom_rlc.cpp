@@ -504,6 +504,7 @@ const char * eeBackupModel(uint8_t i_fileSrc)
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
+  dirCacheInvalidate();
 
   EFile theFile2;
   theFile2.openRd(FILE_MODEL(i_fileSrc));
@@ -956,6 +957,7 @@ void eepromBackup()
 
   // open the file for writing...
   f_open(&file, path, FA_WRITE | FA_CREATE_ALWAYS);
+  dirCacheInvalidate();
 
   for (int i=0; i<EEPROM_SIZE; i+=1024) {
     UINT count;
@@ -36,6 +36,7 @@ const char *writeFileBin(const char *filename, const uint8_t *data,
   if (result != FR_OK) {
     return SDCARD_ERROR(result);
   }
+  dirCacheInvalidate();
 
   *(uint32_t*)&buf[0] = OTX_FOURCC;
   buf[4] = version;
@@ -168,6 +168,7 @@ const char* writeFileYaml(const char* path, const YamlNode* root_node, uint8_t*
     if (result != FR_OK) {
         return SDCARD_ERROR(result);
     }
+    dirCacheInvalidate();
       
     YamlTreeWalker tree;
     tree.reset(root_node, data);
@@ -196,6 +197,14 @@ const char * writeGeneralSettings()
 
 
 const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t size)
+{
+    char path[256];
+    getModelPath(path, filename);
+
+    return readModelYamlFile(path, buffer, size);
+}
+
+const char * readModelYamlFile(const char * path, uint8_t * buffer, uint32_t size)
 {
     // YAML reader
     TRACE("YAML model reader");
@@ -214,9 +223,6 @@ const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t siz
         return "YAML size error";
     }
     
-    char path[256];
-    getModelPath(path, filename);
-
     YamlTreeWalker tree;
     tree.reset(data_nodes, buffer);
 
@@ -355,6 +361,9 @@ void swapModels(uint8_t id1, uint8_t id2)
   GET_FILENAME(fname1_tmp, MODELS_PATH, model_idx_1, ".tmp");
   GET_FILENAME(fname2, MODELS_PATH, model_idx_2, YAML_EXT);
 
+  // model files are renamed below
+  dirCacheInvalidate();
+
   FILINFO fno;
   if (f_stat(fname2,&fno) != FR_OK) {
     if (f_stat(fname1,&fno) == FR_OK) {
@@ -400,6 +409,8 @@ int8_t deleteModel(uint8_t idx)
     return -1;
   }
 
+  dirCacheInvalidate();
+
   modelHeaders[idx].name[0] = '\0';
   return 0;
 }
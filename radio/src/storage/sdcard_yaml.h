@@ -25,4 +25,5 @@ constexpr uint8_t MODELIDX_STRLEN = sizeof(MODEL_FILENAME_PREFIX "00");
 const char * loadRadioSettingsYaml();
 const char * writeModelYaml(const char* filename);
 const char * readModelYaml(const char * filename, uint8_t * buffer, uint32_t size);
+const char * readModelYamlFile(const char * path, uint8_t * buffer, uint32_t size);
 void getModelNumberStr(uint8_t idx, char* model_idx);
@@ -41,6 +41,13 @@ void storageDirty(uint8_t msk)
   storageDirtyMsk |= msk;
   storageDirtyTime10ms = get_tmr10ms();
 
+  if (msk & EE_MODEL) {
+    invalidateCalculatedSensors();
+#if defined(GVARS)
+    invalidateGVarCache();
+#endif
+  }
+
 #if defined(RTC_BACKUP_RAM)
   rambackupDirtyMsk = storageDirtyMsk;
   rambackupDirtyTime10ms = storageDirtyTime10ms;
@@ -191,6 +198,11 @@ void postModelLoad(bool alarms)
 
   loadCurves();
 
+  invalidateCalculatedSensors();
+#if defined(GVARS)
+  invalidateGVarCache();
+#endif
+
   resumeMixerCalculations();
   if (pulsesStarted()) {
 #if defined(GUI)
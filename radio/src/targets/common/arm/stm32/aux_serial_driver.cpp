@@ -22,6 +22,27 @@
 #include "opentx.h"
 #include "targets/horus/board.h"
 
+#if defined(SBUS_TRAINER)
+// SBUS frames are separated by a gap, the idle line interrupt fires at the end
+// of each frame and the bytes received by DMA are decoded right away
+template <class T>
+static void sbusIdleLineReceived(T & fifo)
+{
+  uint8_t frame[SBUS_FRAME_SIZE];
+  uint32_t size = 0;
+  uint8_t rxchar;
+
+  while (fifo.pop(rxchar)) {
+    if (size < SBUS_FRAME_SIZE)
+      frame[size] = rxchar;
+    size++;
+  }
+
+  if (currentTrainerMode == TRAINER_MODE_MASTER_BATTERY_COMPARTMENT)
+    processSbusFrame(frame, ppmInput, size);
+}
+#endif
+
 #if defined(AUX_SERIAL)
 uint8_t auxSerialMode = UART_MODE_COUNT;  // Prevent debug output before port is setup
 Fifo<uint8_t, 512> auxSerialTxFifo;
@@ -101,6 +122,13 @@ void auxSerialSetup(unsigned int baudrate, bool dma, uint16_t length, uint16_t p
     USART_DMACmd(AUX_SERIAL_USART, USART_DMAReq_Rx, ENABLE);
     USART_Cmd(AUX_SERIAL_USART, ENABLE);
     DMA_Cmd(AUX_SERIAL_DMA_Stream_RX, ENABLE);
+#if defined(SBUS_TRAINER)
+    if (auxSerialMode == UART_MODE_SBUS_TRAINER) {
+      USART_ITConfig(AUX_SERIAL_USART, USART_IT_IDLE, ENABLE);
+      NVIC_SetPriority(AUX_SERIAL_USART_IRQn, 7);
+      NVIC_EnableIRQ(AUX_SERIAL_USART_IRQn);
+    }
+#endif
     return;
   }
 #endif
@@ -193,6 +221,17 @@ extern "C" void AUX_SERIAL_USART_IRQHandler(void)
 {
   DEBUG_INTERRUPT(INT_SER2);
 
+#if defined(SBUS_TRAINER) && defined(AUX_SERIAL_DMA_Stream_RX)
+  if (auxSerialMode == UART_MODE_SBUS_TRAINER) {
+    // bytes are received by DMA, reading DR after SR clears the IDLE flag
+    if (USART_GetITStatus(AUX_SERIAL_USART, USART_IT_IDLE) != RESET) {
+      (void)AUX_SERIAL_USART->DR;
+      sbusIdleLineReceived(auxSerialRxFifo);
+    }
+    return;
+  }
+#endif
+
   // Send
   if (USART_GetITStatus(AUX_SERIAL_USART, USART_IT_TXE) != RESET) {
     uint8_t txchar;
@@ -298,6 +337,13 @@ void aux2SerialSetup(unsigned int baudrate, bool dma, uint16_t length, uint16_t
     USART_DMACmd(AUX2_SERIAL_USART, USART_DMAReq_Rx, ENABLE);
     USART_Cmd(AUX2_SERIAL_USART, ENABLE);
     DMA_Cmd(AUX2_SERIAL_DMA_Stream_RX, ENABLE);
+#if defined(SBUS_TRAINER)
+    if (aux2SerialMode == UART_MODE_SBUS_TRAINER) {
+      USART_ITConfig(AUX2_SERIAL_USART, USART_IT_IDLE, ENABLE);
+      NVIC_SetPriority(AUX2_SERIAL_USART_IRQn, 7);
+      NVIC_EnableIRQ(AUX2_SERIAL_USART_IRQn);
+    }
+#endif
   }
   else {
     USART_Cmd(AUX2_SERIAL_USART, ENABLE);
@@ -385,6 +431,17 @@ extern "C" void AUX2_SERIAL_USART_IRQHandler(void)
 {
   DEBUG_INTERRUPT(INT_SER2);
 
+#if defined(SBUS_TRAINER)
+  if (aux2SerialMode == UART_MODE_SBUS_TRAINER) {
+    // bytes are received by DMA, reading DR after SR clears the IDLE flag
+    if (USART_GetITStatus(AUX2_SERIAL_USART, USART_IT_IDLE) != RESET) {
+      (void)AUX2_SERIAL_USART->DR;
+      sbusIdleLineReceived(aux2SerialRxFifo);
+    }
+    return;
+  }
+#endif
+
   // Send
   if (USART_GetITStatus(AUX2_SERIAL_USART, USART_IT_TXE) != RESET) {
     uint8_t txchar;
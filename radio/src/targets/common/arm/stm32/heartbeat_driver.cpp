@@ -87,8 +87,7 @@ void check_intmodule_heartbeat()
 #endif
     EXTI_ClearITPendingBit(INTMODULE_HEARTBEAT_EXTI_LINE);
 
-    mixerSchedulerResetTimer();
-    mixerSchedulerISRTrigger();
+    mixerSchedulerModuleTrigger(INTERNAL_MODULE);
   }
 }
 #endif
@@ -162,6 +162,8 @@
 #define LSM6DS_ENABLE_AXIS                      0x07
 #define LSM6DS_FIFO_DIFF_L                      0x3a
 #define LSM6DS_FIFO_DIFF_MASK                   0x0fff
+#define LSM6DS_FIFO_PATTERN_L                   0x3c
+#define LSM6DS_FIFO_PATTERN_MASK                0x03ff
 #define LSM6DS_FIFO_DATA_OUT_L                  0x3e
 #define LSM6DS_FIFO_ELEMENT_LEN_BYTE            6
 #define LSM6DS_FIFO_BYTE_FOR_CHANNEL            2
@@ -185,11 +187,14 @@
 
 static const char configure[][2] = {
   {LSM6DS_ACCEL_AXIS_EN_ADDR, 0x38},
-  {LSM6DS_ACCEL_ODR_ADDR, (0x3 << 4) | (0x1 << 2) | (0x3 << 0)},
+  {LSM6DS_ACCEL_ODR_ADDR, (LSM6DS_ODR_104HZ_VAL << 4) | (0x1 << 2) | (0x3 << 0)},
   {LSM6DS_GYRO_AXIS_EN_ADDR, 0x38},
-  {LSM6DS_GYRO_ODR_ADDR, (3 << 4) | (3 << 2) | (0 << 0)},
+  {LSM6DS_GYRO_ODR_ADDR, (LSM6DS_ODR_104HZ_VAL << 4) | (3 << 2) | (0 << 0)},
   {LSM6DS_INT1_CTRL_ADDR, 0x3},
   {LSM6DS_INT2_CTRL_ADDR, 0x3},
+  // gyro and accel without decimation, FIFO in continuous mode at the same rate
+  {LSM6DS_FIFO_CTRL3_ADDR, (0x1 << 3) | (0x1 << 0)},
+  {LSM6DS_FIFO_MODE_ADDR, (LSM6DS_ODR_104HZ_VAL << 3) | LSM6DS_FIFO_MODE_CONTINUOS},
 };
 
 static void i2c2Init()
@@ -324,7 +329,7 @@ int gyroInit()
   return 0;
 }
 
-int gyroRead(uint8_t buffer[GYRO_BUFFER_LENGTH])
+static int readGyroRegisters(uint8_t address, uint8_t * buffer, uint16_t count)
 {
   if (!I2C2_WaitEventCleared(I2C_FLAG_BUSY))
     return -1;
@@ -337,7 +342,7 @@ int gyroRead(uint8_t buffer[GYRO_BUFFER_LENGTH])
   if (!I2C2_WaitEvent(I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED))
     return -1;
 
-  I2C_SendData(I2C_B2, LSM6DS_GYRO_OUT_X_L_ADDR);
+  I2C_SendData(I2C_B2, address);
   if (!I2C2_WaitEvent(I2C_EVENT_MASTER_BYTE_TRANSMITTED))
     return -1;
 
@@ -348,8 +353,8 @@ int gyroRead(uint8_t buffer[GYRO_BUFFER_LENGTH])
   I2C_Send7bitAddress(I2C_B2, LSM6DS_ADDRESS, I2C_Direction_Receiver);
 
   I2C_AcknowledgeConfig(I2C_B2, ENABLE);
-  for (uint8_t i=0; i<GYRO_BUFFER_LENGTH; i++) {
-    if (i == GYRO_BUFFER_LENGTH - 1)
+  for (uint16_t i=0; i<count; i++) {
+    if (i == count - 1)
       I2C_AcknowledgeConfig(I2C_B2, DISABLE);
     if (!I2C2_WaitEvent(I2C_EVENT_MASTER_BYTE_RECEIVED))
       return -1;
@@ -359,3 +364,31 @@ int gyroRead(uint8_t buffer[GYRO_BUFFER_LENGTH])
   I2C_GenerateSTOP(I2C_B2, ENABLE);
   return 0;
 }
+
+// Reads up to count gyro + accel samples from the FIFO, in one burst
+// (the FIFO output register address rolls over). Returns the number of samples
+int gyroReadFifo(int16_t samples[][GYRO_VALUES_COUNT], uint8_t count)
+{
+  uint8_t status[4];
+  if (readGyroRegisters(LSM6DS_FIFO_DIFF_L, status, sizeof(status)) < 0)
+    return -1;
+
+  uint16_t words = (status[0] | (status[1] << 8)) & LSM6DS_FIFO_DIFF_MASK;
+  uint16_t pattern = (status[2] | (status[3] << 8)) & LSM6DS_FIFO_PATTERN_MASK;
+
+  // after an overrun the next word may not be the gyro X of a sample
+  if (pattern > 0 && pattern < GYRO_VALUES_COUNT) {
+    uint8_t skip = GYRO_VALUES_COUNT - pattern;
+    if (skip > words)
+      return 0;
+    if (readGyroRegisters(LSM6DS_FIFO_DATA_OUT_L, (uint8_t *)samples[0], skip * sizeof(int16_t)) < 0)
+      return -1;
+    words -= skip;
+  }
+
+  uint8_t result = min<uint16_t>(words / GYRO_VALUES_COUNT, count);
+  if (result > 0 && readGyroRegisters(LSM6DS_FIFO_DATA_OUT_L, (uint8_t *)samples[0], result * GYRO_BUFFER_LENGTH) < 0)
+    return -1;
+
+  return result;
+}
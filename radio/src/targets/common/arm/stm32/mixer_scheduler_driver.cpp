@@ -26,6 +26,11 @@
 
 #include "FreeRTOSConfig.h"
 
+// timer counter when the elapsed time was last accounted
+static uint16_t mixerSchedulerLastCount = 0;
+// the last reload was accounted before its interrupt was handled
+static bool mixerSchedulerReloadAccounted = false;
+
 // Start scheduler with default period
 void mixerSchedulerStart()
 {
@@ -37,6 +42,8 @@ void mixerSchedulerStart()
   MIXER_SCHEDULER_TIMER->CCMR1 = 0;
   MIXER_SCHEDULER_TIMER->ARR   = getMixerSchedulerPeriod() - 1;
   MIXER_SCHEDULER_TIMER->EGR   = TIM_EGR_UG;   // reset timer
+  mixerSchedulerLastCount = 0;
+  mixerSchedulerReloadAccounted = false;
 
   NVIC_EnableIRQ(MIXER_SCHEDULER_TIMER_IRQn);
   NVIC_SetPriority(MIXER_SCHEDULER_TIMER_IRQn,
@@ -57,9 +64,30 @@ void mixerSchedulerResetTimer()
 {
   mixerSchedulerDisableTrigger();
   MIXER_SCHEDULER_TIMER->CNT = 0;
+  mixerSchedulerLastCount = 0;
   mixerSchedulerEnableTrigger();
 }
 
+uint16_t mixerSchedulerTimerElapsed()
+{
+  __disable_irq();
+  uint16_t count = MIXER_SCHEDULER_TIMER->CNT;
+  uint16_t elapsed;
+  if ((MIXER_SCHEDULER_TIMER->SR & TIM_SR_UIF) && !mixerSchedulerReloadAccounted) {
+    // the counter was reloaded and the interrupt is still pending: read it
+    // again, the first read may be from before the reload
+    count = MIXER_SCHEDULER_TIMER->CNT;
+    elapsed = MIXER_SCHEDULER_TIMER->ARR + 1 - mixerSchedulerLastCount + count;
+    mixerSchedulerReloadAccounted = true;
+  }
+  else {
+    elapsed = count - mixerSchedulerLastCount;
+  }
+  mixerSchedulerLastCount = count;
+  __enable_irq();
+  return elapsed;
+}
+
 void mixerSchedulerEnableTrigger()
 {
   MIXER_SCHEDULER_TIMER->DIER |= TIM_DIER_UIE; // enable interrupt
@@ -75,6 +103,15 @@ extern "C" void MIXER_SCHEDULER_TIMER_IRQHandler(void)
   MIXER_SCHEDULER_TIMER->SR &= ~TIM_SR_UIF; // clear flag
   mixerSchedulerDisableTrigger();
 
+  // elapsed period, unless mixerSchedulerTimerElapsed() already accounted it
+  uint16_t elapsed = 0;
+  if (!mixerSchedulerReloadAccounted) {
+    elapsed = MIXER_SCHEDULER_TIMER->ARR + 1 - mixerSchedulerLastCount;
+    mixerSchedulerLastCount = 0;
+  }
+  mixerSchedulerReloadAccounted = false;
+  mixerSchedulerTimerTick(elapsed);
+
   // set next period
   MIXER_SCHEDULER_TIMER->ARR = getMixerSchedulerPeriod() - 1;
 
@@ -48,6 +48,9 @@ void setSelectedUsbMode(int mode);
 
 uint32_t usbSerialFreeSpace();
 void     usbSerialPutc(uint8_t c);
+uint32_t usbSerialWrite(const uint8_t * data, uint32_t size);
+uint8_t * usbSerialClaim(uint32_t * size);
+void     usbSerialCommit(uint32_t size);
 
 uint32_t usbSerialBaudRate(void);
 
@@ -25,6 +25,7 @@
 
 // include STM32 headers and generic board defs
 #include "board_common.h"
+#include <string.h>
 
 extern "C" {
 
@@ -205,17 +206,23 @@ uint32_t usbSerialFreeSpace()
          1;
 }
 
-void usbSerialPutc(uint8_t c)
-{
-  /*
-    Apparently there is no reliable way to tell if the
-    virtual serial port is opened or not.
+/*
+  Apparently there is no reliable way to tell if the
+  virtual serial port is opened or not.
 
-    The cdcConnected variable only reports the state
-    of the physical USB connection.
-  */
+  The cdcConnected variable only reports the state
+  of the physical USB connection.
+*/
+
+// Set between usbSerialClaim() and usbSerialCommit()
+static volatile bool usbSerialClaimed = false;
 
-  if (!cdcConnected) return;
+// Copies as much of the data as fits in the circular buffer, with interrupts
+// disabled once for the whole span. Returns the number of bytes written.
+// While a claim is open, the data is dropped (0 is returned)
+uint32_t usbSerialWrite(const uint8_t * data, uint32_t size)
+{
+  if (!cdcConnected) return 0;
 
   /*
     APP_Rx_Buffer and associated variables must be modified
@@ -228,10 +235,62 @@ void usbSerialPutc(uint8_t c)
   uint32_t prim = __get_PRIMASK();
   __disable_irq();
 
-  APP_Rx_Buffer[APP_Rx_ptr_in] = c;
-  APP_Rx_ptr_in = (APP_Rx_ptr_in + 1) % APP_RX_DATA_SIZE;
+  if (usbSerialClaimed) {
+    // the claimed span starts at APP_Rx_ptr_in, writing here would
+    // be overwritten and the commit would send unwritten bytes
+    if (!prim) __enable_irq();
+    return 0;
+  }
+
+  uint32_t in = APP_Rx_ptr_in;
+  uint32_t count = usbSerialFreeSpace();
+  if (count > size)
+    count = size;
+  uint32_t first = APP_RX_DATA_SIZE - in;
+  if (first > count)
+    first = count;
+  memcpy(&APP_Rx_Buffer[in], data, first);
+  memcpy(APP_Rx_Buffer, data + first, count - first);
+  APP_Rx_ptr_in = (in + count) % APP_RX_DATA_SIZE;
+
+  if (!prim) __enable_irq();
+
+  return count;
+}
+
+void usbSerialPutc(uint8_t c)
+{
+  usbSerialWrite(&c, 1);
+}
 
+// Contiguous free space at the write position, filled in place by the caller
+// and then handed to the USB interrupt with usbSerialCommit(). Every claim
+// must be followed by a commit, usbSerialWrite() drops its data in between
+// (TRACE, Lua serialWrite()) so that the claimed span can't move
+uint8_t * usbSerialClaim(uint32_t * size)
+{
+  uint32_t prim = __get_PRIMASK();
+  __disable_irq();
+  usbSerialClaimed = true;
   if (!prim) __enable_irq();
+
+  uint32_t in = APP_Rx_ptr_in;
+  uint32_t out = APP_Rx_ptr_out % APP_RX_DATA_SIZE;
+
+  if (!cdcConnected)
+    *size = 0;
+  else if (out > in)
+    *size = out - in - 1;
+  else
+    *size = APP_RX_DATA_SIZE - in - (out == 0 ? 1 : 0);
+
+  return &APP_Rx_Buffer[in];
+}
+
+void usbSerialCommit(uint32_t size)
+{
+  APP_Rx_ptr_in = (APP_Rx_ptr_in + size) % APP_RX_DATA_SIZE;
+  usbSerialClaimed = false;
 }
 
 /**
@@ -41,8 +41,10 @@
 // Save some RAM on smaller STM32 processors. Slightly lowers USB mass storage speed
 #if defined(STM32F2) && !defined(BOOT)
 #define MSC_MEDIA_PACKET             512
+#define MSC_STORAGE_BUFFER           2048
 #else
 #define MSC_MEDIA_PACKET             4096
+#define MSC_STORAGE_BUFFER           16384
 #endif
 
 #define HID_IN_EP                    0x81
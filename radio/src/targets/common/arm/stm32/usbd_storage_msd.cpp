@@ -31,6 +31,9 @@ extern "C" {
 #include "usbd_msc_mem.h"
 #include "usb_conf.h"
 
+// bytes left in the current SCSI READ10 / WRITE10 command (usbd_msc_scsi.c)
+extern uint32_t SCSI_blk_len;
+
 enum MassstorageLuns {
   STORAGE_SDCARD_LUN,
   STORAGE_EEPROM_LUN,
@@ -166,12 +169,41 @@ int8_t STORAGE_GetCapacity (uint8_t lun, uint32_t *block_num, uint32_t *block_si
   return 0;
 }
 
+/*
+  The SCSI layer hands over one MSC_MEDIA_PACKET at a time. SD card accesses
+  are aggregated in a bigger buffer, limited to the current SCSI command:
+  - reads fetch up to MSC_STORAGE_BUFFER bytes with a single multi-block
+    transfer, the following packets of the command are then served from RAM
+  - writes are gathered and sent with a single multi-block transfer when the
+    buffer is full or with the last packet of the command, before its status
+    is returned to the host
+*/
+#define STORAGE_BUFFER_BLOCKS (MSC_STORAGE_BUFFER / BLOCK_SIZE)
+
+static uint8_t storageBuffer[MSC_STORAGE_BUFFER] __DMA;
+static uint32_t storageBufferAddr;
+static uint16_t storageBufferCount;
+static bool storageBufferDirty;
+
+static int8_t storageFlush()
+{
+  if (!storageBufferDirty)
+    return 0;
+
+  storageBufferDirty = false;
+  uint16_t count = storageBufferCount;
+  storageBufferCount = 0;
+  return (__disk_write(0, storageBuffer, storageBufferAddr, count) == RES_OK) ? 0 : -1;
+}
+
 uint8_t lunReady[STORAGE_LUN_NBR];
 
 void usbPluggedIn()
 {
   lunReady[STORAGE_SDCARD_LUN] = 1;
   lunReady[STORAGE_EEPROM_LUN] = 1;
+  storageBufferCount = 0;
+  storageBufferDirty = false;
 }
 
 /**
@@ -220,9 +252,30 @@ int8_t STORAGE_Read (uint8_t lun,
     return (fat12Read(buf, blk_addr, blk_len) == 0) ? 0 : -1;
   }
 
-  // read without cache
-  return (__disk_read(0, buf, blk_addr, blk_len) == RES_OK) ? 0 : -1;
+  if (storageFlush() < 0)
+    return -1;
+
+  if (storageBufferCount == 0 || blk_addr < storageBufferAddr ||
+      blk_addr + blk_len > storageBufferAddr + storageBufferCount) {
+    uint32_t remaining = SCSI_blk_len / BLOCK_SIZE;
+    if (remaining <= blk_len || blk_len >= STORAGE_BUFFER_BLOCKS) {
+      // nothing to read ahead
+      storageBufferCount = 0;
+      return (__disk_read(0, buf, blk_addr, blk_len) == RES_OK) ? 0 : -1;
+    }
+    uint16_t count = min<uint32_t>(remaining, STORAGE_BUFFER_BLOCKS);
+    if (__disk_read(0, storageBuffer, blk_addr, count) != RES_OK) {
+      storageBufferCount = 0;
+      return -1;
+    }
+    storageBufferAddr = blk_addr;
+    storageBufferCount = count;
+  }
+
+  memcpy(buf, &storageBuffer[(blk_addr - storageBufferAddr) * BLOCK_SIZE], blk_len * BLOCK_SIZE);
+  return 0;
 }
+
 /**
   * @brief  Write data to the medium
   * @param  lun : logical unit number
@@ -243,8 +296,32 @@ int8_t STORAGE_Write (uint8_t lun,
     return (fat12Write(buf, blk_addr, blk_len) == 0) ? 0 : -1;
   }
 
-  // write without cache
-  return (__disk_write(0, buf, blk_addr, blk_len) == RES_OK) ? 0 : -1;
+  if (!storageBufferDirty) {
+    // drop the read ahead data
+    storageBufferCount = 0;
+  }
+  else if (blk_addr != storageBufferAddr + storageBufferCount ||
+           storageBufferCount + blk_len > STORAGE_BUFFER_BLOCKS) {
+    if (storageFlush() < 0)
+      return -1;
+  }
+
+  bool last = (blk_len * BLOCK_SIZE >= SCSI_blk_len);
+  if (storageBufferCount == 0 && (last || blk_len >= STORAGE_BUFFER_BLOCKS)) {
+    // nothing to gather
+    return (__disk_write(0, buf, blk_addr, blk_len) == RES_OK) ? 0 : -1;
+  }
+
+  if (storageBufferCount == 0)
+    storageBufferAddr = blk_addr;
+  memcpy(&storageBuffer[storageBufferCount * BLOCK_SIZE], buf, blk_len * BLOCK_SIZE);
+  storageBufferCount += blk_len;
+  storageBufferDirty = true;
+
+  if (last || storageBufferCount == STORAGE_BUFFER_BLOCKS)
+    return storageFlush();
+
+  return 0;
 }
 
 /**
@@ -24,7 +24,8 @@
 #if GPS_USART_BAUDRATE > 9600
   Fifo<uint8_t, 256> gpsRxFifo;
 #else
-  Fifo<uint8_t, 64> gpsRxFifo;
+  // room for a whole UBX NAV-PVT message
+  Fifo<uint8_t, 128> gpsRxFifo;
 #endif
 
 void gpsInit(uint32_t baudrate)
@@ -82,6 +83,12 @@ void gpsSendByte(uint8_t byte)
   USART_ITConfig(GPS_USART, USART_IT_TXE, ENABLE);
 }
 
+// true when gpsSendByte() won't wait for count bytes
+bool gpsTxHasSpace(uint32_t count)
+{
+  return gpsTxFifo.hasSpace(count);
+}
+
 extern "C" void GPS_USART_IRQHandler(void)
 {
   // Send
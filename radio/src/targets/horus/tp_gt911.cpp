@@ -813,6 +813,7 @@ extern "C" void TOUCH_INT_EXTI_IRQHandler1(void)
 {
   if (EXTI_GetITStatus(TOUCH_INT_EXTI_LINE1) != RESET) {
     touchEventOccured = true;
+    menusTaskWakeup();
     EXTI_ClearITPendingBit(TOUCH_INT_EXTI_LINE1);
   }
 }
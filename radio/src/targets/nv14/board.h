@@ -46,6 +46,7 @@
 #define MB                              *1024*1024
 #define LUA_MEM_EXTRA_MAX               (2 MB)    // max allowed memory usage for Lua bitmaps (in bytes)
 #define LUA_MEM_MAX                     (6 MB)    // max allowed memory usage for complete Lua  (in bytes), 0 means unlimited
+#define LUA_ARENA_SIZE                  (1 MB)    // Lua size class pools (in bytes), bigger blocks go to the heap
 
 // HSI is at 168Mhz (over-drive is not enabled!)
 #define PERI1_FREQUENCY                 42000000
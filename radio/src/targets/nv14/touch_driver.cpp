@@ -507,6 +507,7 @@ extern "C" void EXTI9_5_IRQHandler(void)
   if (EXTI_GetITStatus(EXTI_Line9) != RESET) {
     EXTI_ClearITPendingBit(EXTI_Line9);
     touchEventOccured = true;
+    menusTaskWakeup();
   }
 }
 
@@ -0,0 +1,471 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+/*
+ * modelcheck: headless batch checker for YAML models
+ *
+ * Loads every model found in a directory with the radio YAML loader,
+ * runs an input sweep through evalMixes() and reports, for each model:
+ *  - the mixer cost (evalMixes() average and max time)
+ *  - the channel outputs for each stick at -100/-50/0/50/100%
+ *  - the mix lines which were never active during the sweep
+ *  - the logical switches cycles
+ *
+ * The firmware state (g_model, mixer state, ...) is global, so the models
+ * are checked in separate worker processes, several at a time.
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+  #include <sys/types.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#include "opentx.h"
+#include "storage/sdcard_yaml.h"
+
+#define MODELCHECK_STICK_STEPS    5
+#define MODELCHECK_DEFAULT_SETTLE 100  // 10ms ticks
+
+struct ModelCheckOptions
+{
+  unsigned jobs = 1;
+  unsigned settle = MODELCHECK_DEFAULT_SETTLE;
+  bool verbose = false;
+};
+
+struct ModelCheckResult
+{
+  uint32_t mixerRuns = 0;
+  uint64_t mixerTotalNs = 0;
+  uint64_t mixerMaxNs = 0;
+  bool mixActive[MAX_MIXERS];
+  int16_t outputs[NUM_STICKS][MODELCHECK_STICK_STEPS][MAX_OUTPUT_CHANNELS];
+};
+
+static const int16_t stickSteps[MODELCHECK_STICK_STEPS] = { -RESX, -RESX / 2, 0, RESX / 2, RESX };
+
+uint16_t anaInValues[NUM_STICKS + NUM_POTS + NUM_SLIDERS] = { 0 };
+
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < NUM_STICKS + NUM_POTS + NUM_SLIDERS)
+    return anaInValues[chan];
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+static void resetMixer()
+{
+  memset(channelOutputs, 0, sizeof(channelOutputs));
+  memset(chans, 0, sizeof(chans));
+  memset(ex_chans, 0, sizeof(ex_chans));
+  memset(act, 0, sizeof(act));
+  memset(swOn, 0, sizeof(swOn));
+  mixerCurrentFlightMode = lastFlightMode = 0;
+  logicalSwitchesReset();
+}
+
+static void resetInputs()
+{
+  memset(anaInValues, 0, sizeof(anaInValues));
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    simuSetSwitch(i, -1);
+  }
+}
+
+static void runMixer(ModelCheckResult & result, unsigned ticks)
+{
+  for (unsigned i = 0; i < ticks; i++) {
+    g_tmr10ms++;
+    getSwitchesPosition(false);
+
+    auto start = std::chrono::steady_clock::now();
+    evalMixes(1);
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    result.mixerRuns++;
+    result.mixerTotalNs += duration;
+    result.mixerMaxNs = std::max<uint64_t>(result.mixerMaxNs, duration);
+
+    for (int m = 0; m < MAX_MIXERS; m++) {
+      if (isMixActive(m)) {
+        result.mixActive[m] = true;
+      }
+    }
+  }
+}
+
+static void sweepInputs(ModelCheckResult & result, const ModelCheckOptions & options)
+{
+  // sticks, one at a time, all switches up
+  for (int stick = 0; stick < NUM_STICKS; stick++) {
+    for (int step = 0; step < MODELCHECK_STICK_STEPS; step++) {
+      resetInputs();
+      anaInValues[stick] = stickSteps[step];
+      runMixer(result, options.settle);
+      memcpy(result.outputs[stick][step], channelOutputs, sizeof(result.outputs[stick][step]));
+    }
+  }
+
+  // switches, one at a time, with all sticks centered then at both ends
+  for (int sw = 0; sw < NUM_SWITCHES; sw++) {
+    for (int8_t pos = -1; pos <= 1; pos++) {
+      for (int step = 0; step < MODELCHECK_STICK_STEPS; step += MODELCHECK_STICK_STEPS / 2) {
+        resetInputs();
+        for (int stick = 0; stick < NUM_STICKS; stick++) {
+          anaInValues[stick] = stickSteps[step];
+        }
+        simuSetSwitch(sw, pos);
+        runMixer(result, options.settle);
+      }
+    }
+  }
+}
+
+static int getLogicalSwitchDependencies(const LogicalSwitchData * ls, int * deps)
+{
+  int count = 0;
+
+  if (ls->func == LS_FUNC_NONE)
+    return 0;
+
+  auto addSwitch = [&](swsrc_t sw) {
+    sw = abs(sw);
+    if (sw >= SWSRC_FIRST_LOGICAL_SWITCH && sw <= SWSRC_LAST_LOGICAL_SWITCH)
+      deps[count++] = sw - SWSRC_FIRST_LOGICAL_SWITCH;
+  };
+
+  auto addSource = [&](mixsrc_t src) {
+    if (src >= MIXSRC_FIRST_LOGICAL_SWITCH && src <= MIXSRC_LAST_LOGICAL_SWITCH)
+      deps[count++] = src - MIXSRC_FIRST_LOGICAL_SWITCH;
+  };
+
+  addSwitch(ls->andsw);
+
+  uint8_t family = lswFamily(ls->func);
+  if (family == LS_FAMILY_BOOL) {
+    addSwitch(ls->v1);
+    addSwitch(ls->v2);
+  }
+  else if (family == LS_FAMILY_COMP) {
+    addSource(ls->v1);
+    addSource(ls->v2);
+  }
+  else if (family == LS_FAMILY_OFS || family == LS_FAMILY_DIFF) {
+    addSource(ls->v1);
+  }
+  // STICKY, EDGE and TIMER keep a state from the previous evaluation
+  // and therefore can't create a loop inside one mixer run
+
+  return count;
+}
+
+static bool findLogicalSwitchCycle(int idx, uint8_t * state, std::vector<int> & stack, std::string & cycle)
+{
+  int deps[3];
+
+  state[idx] = 1; // visiting
+  stack.push_back(idx);
+
+  int count = getLogicalSwitchDependencies(lswAddress(idx), deps);
+  for (int i = 0; i < count; i++) {
+    int dep = deps[i];
+    if (state[dep] == 1) {
+      auto it = std::find(stack.begin(), stack.end(), dep);
+      for (; it != stack.end(); ++it) {
+        cycle += "L" + std::to_string(*it + 1) + " -> ";
+      }
+      cycle += "L" + std::to_string(dep + 1);
+      return true;
+    }
+    if (state[dep] == 0 && findLogicalSwitchCycle(dep, state, stack, cycle)) {
+      return true;
+    }
+  }
+
+  stack.pop_back();
+  state[idx] = 2; // done
+  return false;
+}
+
+static int reportLogicalSwitchCycles(FILE * out)
+{
+  uint8_t state[MAX_LOGICAL_SWITCHES] = { 0 };
+  int cycles = 0;
+
+  for (int i = 0; i < MAX_LOGICAL_SWITCHES; i++) {
+    if (state[i] == 0) {
+      std::vector<int> stack;
+      std::string cycle;
+      if (findLogicalSwitchCycle(i, state, stack, cycle)) {
+        fprintf(out, "  LS cycle: %s\n", cycle.c_str());
+        cycles++;
+        // the switches of that cycle are not explored any further
+        for (int idx : stack) {
+          state[idx] = 2;
+        }
+      }
+    }
+  }
+
+  return cycles;
+}
+
+static int checkModel(const std::string & path, const ModelCheckOptions & options, FILE * out)
+{
+  char name[LEN_MODEL_NAME + 1];
+
+  generalDefault();
+  resetInputs();
+  resetMixer();
+
+  preModelLoad();
+  const char * error = readModelYamlFile(path.c_str(), (uint8_t *)&g_model, sizeof(g_model));
+  if (error) {
+    fprintf(out, "%s: ERROR %s\n", path.c_str(), error);
+    return 1;
+  }
+  postModelLoad(false);
+
+  strncpy(name, g_model.header.name, LEN_MODEL_NAME);
+  name[LEN_MODEL_NAME] = '\0';
+  fprintf(out, "%s: \"%s\"\n", path.c_str(), name);
+
+  ModelCheckResult * result = new ModelCheckResult();
+  memset(result->mixActive, 0, sizeof(result->mixActive));
+  sweepInputs(*result, options);
+
+  fprintf(out, "  mixer: avg %.1fus max %.1fus (%u runs)\n",
+          result->mixerTotalNs / 1000.0 / std::max<uint32_t>(result->mixerRuns, 1),
+          result->mixerMaxNs / 1000.0, result->mixerRuns);
+
+  // channels outputs
+  int lastChannel = -1;
+  for (int ch = 0; ch < MAX_OUTPUT_CHANNELS; ch++) {
+    for (int stick = 0; stick < NUM_STICKS; stick++) {
+      for (int step = 0; step < MODELCHECK_STICK_STEPS; step++) {
+        if (result->outputs[stick][step][ch] != 0)
+          lastChannel = ch;
+      }
+    }
+  }
+  char srcName[32];
+  for (int stick = 0; stick < NUM_STICKS; stick++) {
+    getSourceString(srcName, MIXSRC_FIRST_STICK + stick);
+    fprintf(out, "  outputs for %s:\n", srcName);
+    for (int step = 0; step < MODELCHECK_STICK_STEPS; step++) {
+      fprintf(out, "    %4d%%:", stickSteps[step] * 100 / RESX);
+      for (int ch = 0; ch <= lastChannel || (options.verbose && ch < MAX_OUTPUT_CHANNELS); ch++) {
+        fprintf(out, " %6.1f", calcRESXto1000(result->outputs[stick][step][ch]) / 10.0);
+      }
+      fprintf(out, "\n");
+    }
+  }
+
+  // mix lines never active
+  int unreachable = 0;
+  for (int m = 0; m < MAX_MIXERS; m++) {
+    MixData * mix = mixAddress(m);
+    if (mix->srcRaw == 0)
+      break;
+    if (!result->mixActive[m]) {
+      getSourceString(srcName, mix->srcRaw);
+      fprintf(out, "  unreachable mix line %d: CH%d %s\n", m + 1, mix->destCh + 1, srcName);
+      unreachable++;
+    }
+  }
+
+  int cycles = reportLogicalSwitchCycles(out);
+
+  fprintf(out, "  %d unreachable mix line(s), %d LS cycle(s)\n", unreachable, cycles);
+
+  delete result;
+  return cycles ? 2 : 0;
+}
+
+static std::vector<std::string> listModels(const char * directory)
+{
+  std::vector<std::string> files;
+
+  DIR * dir = opendir(directory);
+  if (!dir)
+    return files;
+
+  while (struct dirent * entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.size() > sizeof(YAML_EXT) - 1 &&
+        name.compare(name.size() - (sizeof(YAML_EXT) - 1), sizeof(YAML_EXT) - 1, YAML_EXT) == 0 &&
+        name != "models.yml") {
+      files.push_back(std::string(directory) + "/" + name);
+    }
+  }
+  closedir(dir);
+
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+#if defined(_WIN32)
+static int checkModels(const std::vector<std::string> & files, const ModelCheckOptions & options)
+{
+  // no fork() here: models are checked one after the other
+  int result = 0;
+  for (auto & file : files) {
+    result = std::max(result, checkModel(file, options, stdout));
+  }
+  return result;
+}
+#else
+static int checkModels(const std::vector<std::string> & files, const ModelCheckOptions & options)
+{
+  std::vector<FILE *> reports(files.size(), nullptr);
+  std::vector<pid_t> workers(files.size(), 0);
+  unsigned running = 0;
+  size_t next = 0;
+  int result = 0;
+
+  while (next < files.size() || running > 0) {
+    while (running < options.jobs && next < files.size()) {
+      reports[next] = tmpfile();
+      if (!reports[next]) {
+        perror("tmpfile");
+        return 1;
+      }
+      fflush(stdout);
+      pid_t pid = fork();
+      if (pid < 0) {
+        perror("fork");
+        return 1;
+      }
+      if (pid == 0) {
+        int res = checkModel(files[next], options, reports[next]);
+        fflush(reports[next]);
+        _exit(res);
+      }
+      workers[next++] = pid;
+      running++;
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid < 0) {
+      perror("wait");
+      return 1;
+    }
+    running--;
+    int res = (WIFEXITED(status) ? WEXITSTATUS(status) : 1);
+    for (size_t i = 0; i < files.size(); i++) {
+      if (workers[i] == pid) {
+        if (!WIFEXITED(status)) {
+          fprintf(reports[i], "%s: ERROR worker crashed (signal %d)\n", files[i].c_str(), WTERMSIG(status));
+        }
+        break;
+      }
+    }
+    result = std::max(result, res);
+  }
+
+  // reports are printed in models order
+  char buffer[4096];
+  for (FILE * report : reports) {
+    rewind(report);
+    size_t len;
+    while ((len = fread(buffer, 1, sizeof(buffer), report)) > 0) {
+      fwrite(buffer, 1, len, stdout);
+    }
+    fclose(report);
+  }
+
+  return result;
+}
+#endif
+
+static void usage(const char * program)
+{
+  fprintf(stderr, "Usage: %s [-j jobs] [-s settle_ticks] [-v] <models directory>\n", program);
+  fprintf(stderr, "  -j jobs          number of models checked in parallel (default 1)\n");
+  fprintf(stderr, "  -s settle_ticks  10ms mixer ticks run for each input position (default %d)\n", MODELCHECK_DEFAULT_SETTLE);
+  fprintf(stderr, "  -v               print all channels\n");
+  fprintf(stderr, "Exit code: 0 = OK, 1 = load error, 2 = LS cycle found\n");
+}
+
+int main(int argc, char ** argv)
+{
+  ModelCheckOptions options;
+  const char * directory = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+      options.jobs = std::max(1, atoi(argv[++i]));
+    }
+    else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      options.settle = std::max(1, atoi(argv[++i]));
+    }
+    else if (!strcmp(argv[i], "-v")) {
+      options.verbose = true;
+    }
+    else if (argv[i][0] != '-' && !directory) {
+      directory = argv[i];
+    }
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if (!directory) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // host paths are used as they are
+  simuFatfsSetPaths("", nullptr);
+  simuInit();
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+  if (g_tmr10ms == 0) {
+    g_tmr10ms = 1;
+  }
+
+  std::vector<std::string> files = listModels(directory);
+  if (files.empty()) {
+    fprintf(stderr, "No model found in %s\n", directory);
+    return 1;
+  }
+
+  return checkModels(files, options);
+}
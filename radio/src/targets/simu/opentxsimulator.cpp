@@ -65,7 +65,7 @@ void firmwareTraceCb(const char * text)
 OpenTxSimulator::OpenTxSimulator() :
   SimulatorInterface(),
   m_timer10ms(nullptr),
-  m_resetOutputsData(true),
+  m_outputsVersion(0),
   m_stopRequested(false)
 {
   tracebackDevices.clear();
@@ -117,7 +117,6 @@ void OpenTxSimulator::init()
     connect(this, SIGNAL(stopped()), m_timer10ms, SLOT(stop()));
   }
 
-  m_resetOutputsData = true;
   setStopRequested(false);
 
   QMutexLocker lckr(&m_mtxSimuMain);
@@ -491,9 +490,7 @@ void OpenTxSimulator::run()
 
   checkLcdChanged();
 
-  if (!(loops % 5)) {
-    checkOutputsChanged();
-  }
+  publishOutputs();
 
   if (!(loops % (SIMULATOR_INTERFACE_HEARTBEAT_PERIOD / 10))) {
     emit heartbeat(loops, simuTimerMicros() / 1000);
@@ -522,66 +519,44 @@ bool OpenTxSimulator::checkLcdChanged()
   return false;
 }
 
-void OpenTxSimulator::checkOutputsChanged()
+void OpenTxSimulator::publishOutputs()
 {
-  static TxOutputs lastOutputs;
-  static size_t chansDim = DIM(channelOutputs);
+  static TxOutputs outputs;
   const static int16_t limit = 512 * 2;
-  qint32 tmpVal;
   uint8_t i, idx;
   const uint8_t phase = getFlightMode();  // opentx.cpp
   const uint8_t mode = getStickMode();
 
-  for (i=0; i < chansDim; i++) {
-    if (lastOutputs.chans[i] != channelOutputs[i] || m_resetOutputsData) {
-      emit channelOutValueChange(i, channelOutputs[i], (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit));
-      emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, channelOutputs[i]);
-      lastOutputs.chans[i] = channelOutputs[i];
-    }
-    if (lastOutputs.ex_chans[i] != ex_chans[i] || m_resetOutputsData) {
-      emit channelMixValueChange(i, ex_chans[i], limit * 2);
-      emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, ex_chans[i]);
-      lastOutputs.ex_chans[i] = ex_chans[i];
-    }
+  outputs.chansCount = min<uint8_t>(DIM(channelOutputs), CPN_MAX_CHNOUT);
+  for (i=0; i < outputs.chansCount; i++) {
+    outputs.chans[i] = channelOutputs[i];
+    outputs.ex_chans[i] = ex_chans[i];
   }
+  outputs.chanLimit = (g_model.extendedLimits ? limit * LIMIT_EXT_PERCENT / 100 : limit);
 
-  for (i=0; i < MAX_LOGICAL_SWITCHES; i++) {
-    tmpVal = (qint32)GET_SWITCH_BOOL(SWSRC_SW1+i);
-    if (lastOutputs.vsw[i] != (bool)tmpVal || m_resetOutputsData) {
-      emit virtualSwValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, tmpVal);
-      lastOutputs.vsw[i] = tmpVal;
-    }
+  outputs.vswCount = min<uint8_t>(MAX_LOGICAL_SWITCHES, CPN_MAX_LOGICAL_SWITCHES);
+  for (i=0; i < outputs.vswCount; i++) {
+    outputs.vsw[i] = GET_SWITCH_BOOL(SWSRC_SW1+i);
   }
 
+  outputs.trimsCount = Board::TRIM_AXIS_COUNT;
   for (i=0; i < Board::TRIM_AXIS_COUNT; i++) {
     if (i < 4)  // swap axes
       idx = modn12x3[4 * mode + i];
     else
       idx = i;
 
-    tmpVal = getTrimValue(getTrimFlightMode(phase, idx), idx);
-    if (lastOutputs.trims[i] != tmpVal || m_resetOutputsData) {
-      emit trimValueChange(i, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, tmpVal);
-      lastOutputs.trims[i] = tmpVal;
-    }
+    outputs.trims[i] = getTrimValue(getTrimFlightMode(phase, idx), idx);
   }
 
-  tmpVal = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
-  if (lastOutputs.trimRange != tmpVal || m_resetOutputsData) {
-    emit trimRangeChange(Board::TRIM_AXIS_COUNT, -tmpVal, tmpVal);
-    emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, Board::TRIM_AXIS_COUNT, tmpVal);
-    lastOutputs.trimRange = tmpVal;
-  }
+  outputs.trimRange = g_model.extendedTrims ? TRIM_EXTENDED_MAX : TRIM_MAX;
 
-  if (lastOutputs.phase != phase || m_resetOutputsData) {
-    emit phaseChanged(phase, getCurrentPhaseName());
-    emit outputValueChange(OUTPUT_SRC_PHASE, 0, qint16(phase));
-    lastOutputs.phase = phase;
-  }
+  outputs.phase = phase;
+  strncpy(outputs.phaseName, getCurrentPhaseName().toLatin1().constData(), sizeof(outputs.phaseName) - 1);
 
 #if defined(GVAR_VALUE) && defined(GVARS)
+  outputs.gvarsCount = MAX_GVARS;
+  outputs.phasesCount = MAX_FLIGHT_MODES;
   gVarMode_t gvar;
   for (uint8_t gv=0; gv < MAX_GVARS; gv++) {
     gvar.prec = g_model.gvars[gv].prec;
@@ -589,17 +564,34 @@ void OpenTxSimulator::checkOutputsChanged()
     for (uint8_t fm=0; fm < MAX_FLIGHT_MODES; fm++) {
       gvar.mode = fm;
       gvar.value = (int16_t)GVAR_VALUE(gv, getGVarFlightMode(fm, gv));
-      tmpVal = gvar;
-      if (lastOutputs.gvars[fm][gv] != tmpVal || m_resetOutputsData) {
-        lastOutputs.gvars[fm][gv] = tmpVal;
-        emit gVarValueChange(gv, tmpVal);
-        emit outputValueChange(OUTPUT_SRC_GVAR, gv, tmpVal);
-      }
+      outputs.gvars[fm][gv] = gvar;
     }
   }
 #endif
 
-  m_resetOutputsData = false;
+  quint32 version = m_outputsVersion.load(std::memory_order_relaxed);
+  m_outputsVersion.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(&m_outputs, &outputs, sizeof(TxOutputs));
+  m_outputsVersion.store(version + 2, std::memory_order_release);
+}
+
+bool OpenTxSimulator::getOutputs(TxOutputs & outputs, quint32 & version)
+{
+  for (int retry = 0; retry < 10; retry++) {
+    quint32 before = m_outputsVersion.load(std::memory_order_acquire);
+    if (before == version)
+      return false;
+    if (before & 1)
+      continue;
+    memcpy(&outputs, &m_outputs, sizeof(TxOutputs));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (m_outputsVersion.load(std::memory_order_relaxed) == before) {
+      version = before;
+      return true;
+    }
+  }
+  return false;
 }
 
 uint8_t OpenTxSimulator::getStickMode()
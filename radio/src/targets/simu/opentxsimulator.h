@@ -28,6 +28,8 @@
 #include <QObject>
 #include <QTimer>
 
+#include <atomic>
+
 #if defined __GNUC__
   #define DLLEXPORT
 #else
@@ -56,6 +58,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     virtual uint8_t getSensorInstance(uint16_t id, uint8_t defaultValue = 0);
     virtual uint16_t getSensorRatio(uint16_t id);
     virtual const int getCapability(Capability cap);
+    virtual bool getOutputs(TxOutputs & outputs, quint32 & version);
 
     static QVector<QIODevice *> tracebackDevices;
 
@@ -90,7 +93,7 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     bool isStopRequested();
     void setStopRequested(bool stop);
     bool checkLcdChanged();
-    void checkOutputsChanged();
+    void publishOutputs();
     uint8_t getStickMode();
     const char * getPhaseName(unsigned int phase);
     const QString getCurrentPhaseName();
@@ -106,9 +109,13 @@ class DLLEXPORT OpenTxSimulator : public SimulatorInterface
     QMutex m_mtxSettings;
     QMutex m_mtxTbDevices;
     int volumeGain;
-    bool m_resetOutputsData;
     bool m_stopRequested;
 
+    // outputs snapshot, written by the simulator thread only: the version is
+    // odd while an update is in progress (seqlock), readers retry on mismatch
+    TxOutputs m_outputs;
+    std::atomic<quint32> m_outputsVersion;
+
 };
 
 #endif // _OPENTX_SIMULATOR_H_
@@ -744,6 +744,7 @@ bool isJackPlugged()
 void serialPrintf(const char * format, ...) { }
 void serialCrlf() { }
 void serialPutc(char c) { }
+void serialWrite(const char * data, uint32_t size) { }
 
 uint16_t getBatteryVoltage()
 {
@@ -822,6 +823,11 @@ void rtcSetTime(const struct gtm * t)
 void usbSerialPutc(uint8_t c)
 {
 }
+
+uint32_t usbSerialWrite(const uint8_t * data, uint32_t size)
+{
+  return size;
+}
 #endif
 
 #if defined(AUX_SERIAL)
@@ -988,8 +988,12 @@ extern AuxSerialRxFifo auxSerialRxFifo;
 // Gyro driver
 #define GYRO_VALUES_COUNT               6
 #define GYRO_BUFFER_LENGTH              (GYRO_VALUES_COUNT * sizeof(int16_t))
+#define GYRO_SAMPLE_RATE                104   // Hz, gyro and accelerometer
+#define GYRO_RATE_MDPS_PER_LSB          70    // 2000dps full scale
+#define GYRO_ACC_LSB_PER_G              2049  // 16g full scale
+#define GYRO_FIFO_SAMPLES               16
 int gyroInit();
-int gyroRead(uint8_t buffer[GYRO_BUFFER_LENGTH]);
+int gyroReadFifo(int16_t samples[][GYRO_VALUES_COUNT], uint8_t count);
 #define GYRO_MAX_DEFAULT                30
 #define GYRO_MAX_RANGE                  60
 #define GYRO_OFFSET_MIN                 -30
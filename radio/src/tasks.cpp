@@ -163,6 +163,9 @@ TASK_FUNCTION(mixerTask)
     GPIO_ResetBits(EXTMODULE_TX_GPIO, EXTMODULE_TX_GPIO_PIN);
 #endif
 
+    // modules whose frame is due, before the timer can trigger again
+    uint8_t runMask = mixerSchedulerGetRunMask();
+
     // re-enable trigger
     mixerSchedulerEnableTrigger();
 
@@ -182,8 +185,9 @@ TASK_FUNCTION(mixerTask)
       DEBUG_TIMER_START(debugTimerMixer);
       RTOS_LOCK_MUTEX(mixerMutex);
 
+      checkTrainerFrameAge();
       doMixerCalculations();
-      sendSynchronousPulses((1 << INTERNAL_MODULE) | (1 << EXTERNAL_MODULE));
+      sendSynchronousPulses(runMask);
       doMixerPeriodicUpdates();
 
       DEBUG_TIMER_START(debugTimerMixerCalcToUsage);
@@ -211,6 +215,44 @@ TASK_FUNCTION(mixerTask)
 
 
 #define MENU_TASK_PERIOD_TICKS         (50 / RTOS_MS_PER_TICK)    // 50ms
+#define MENU_TASK_MIN_PERIOD_TICKS     (20 / RTOS_MS_PER_TICK)    // 20ms, when woken up early
+
+volatile bool menusTaskWakeupRequest = false;
+
+#if !defined(SIMU)
+// The 1ms timer interrupt (keys, rotary encoder) runs above the FreeRTOS
+// syscall priority and can only set the request flag. The tick interrupt
+// runs at the kernel priority and turns it into a notification of the task
+extern "C" void vApplicationTickHook()
+{
+  if (menusTaskWakeupRequest && menusTaskId.rtos_handle) {
+    menusTaskWakeupRequest = false;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(menusTaskId.rtos_handle, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
+}
+#endif
+
+// Sleep until the end of the period, or earlier when some input is waiting
+static void menusTaskWait(uint32_t start)
+{
+  uint32_t runtime = ((uint32_t)RTOS_GET_TIME() - start);
+#if defined(SIMU)
+  if (runtime < MENU_TASK_PERIOD_TICKS) {
+    RTOS_WAIT_TICKS(MENU_TASK_PERIOD_TICKS - runtime);
+  }
+#else
+  if (runtime < MENU_TASK_MIN_PERIOD_TICKS) {
+    // a wake up request stays pending meanwhile
+    RTOS_WAIT_TICKS(MENU_TASK_MIN_PERIOD_TICKS - runtime);
+    runtime = MENU_TASK_MIN_PERIOD_TICKS;
+  }
+  if (runtime < MENU_TASK_PERIOD_TICKS) {
+    ulTaskNotifyTake(pdTRUE, MENU_TASK_PERIOD_TICKS - runtime);
+  }
+#endif
+}
 
 #if defined(COLORLCD) && defined(CLI)
 bool perMainEnabled = true;
@@ -245,6 +287,11 @@ TASK_FUNCTION(menusTask)
   while (pwrCheck() != e_power_off) {
 #endif
     uint32_t start = (uint32_t)RTOS_GET_TIME();
+    // requests coming during perMain() need another run
+    menusTaskWakeupRequest = false;
+#if !defined(SIMU)
+    ulTaskNotifyTake(pdTRUE, 0);
+#endif
     DEBUG_TIMER_START(debugTimerPerMain);
 #if defined(COLORLCD) && defined(CLI)
     if (perMainEnabled) {
@@ -255,12 +302,9 @@ TASK_FUNCTION(menusTask)
 #endif
     DEBUG_TIMER_STOP(debugTimerPerMain);
     // TODO remove completely massstorage from sky9x firmware
-    uint32_t runtime = ((uint32_t)RTOS_GET_TIME() - start);
     // deduct the thread run-time from the wait, if run-time was more than
     // desired period, then skip the wait all together
-    if (runtime < MENU_TASK_PERIOD_TICKS) {
-      RTOS_WAIT_TICKS(MENU_TASK_PERIOD_TICKS - runtime);
-    }
+    menusTaskWait(start);
 
     resetForcePowerOffRequest();
   }
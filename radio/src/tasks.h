@@ -64,6 +64,16 @@ extern RTOS_DEFINE_STACK(cliStack, CLI_STACK_SIZE);
 void stackPaint();
 void tasksStart();
 
+extern volatile bool menusTaskWakeupRequest;
+
+// Runs the menus task as soon as possible instead of waiting for the end of
+// its period. Only sets a flag, so that it may be called from any interrupt,
+// the FreeRTOS tick hook notifies the task
+inline void menusTaskWakeup()
+{
+  menusTaskWakeupRequest = true;
+}
+
 extern volatile uint16_t timeForcePowerOffPressed;
 inline void resetForcePowerOffRequest()
 {
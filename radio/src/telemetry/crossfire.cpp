@@ -55,26 +55,106 @@ const CrossfireSensor crossfireSensors[] = {
   {0,              0, "UNKNOWN",          UNIT_RAW,               0},
 };
 
+// Conversions applied to a raw field before it is published
+enum CrossfireFieldConversions {
+  CRSF_CONV_NONE,
+  CRSF_CONV_DIV10,
+  CRSF_CONV_MUL10,
+  CRSF_CONV_ALTITUDE,
+  CRSF_CONV_TX_POWER,
+};
+
+struct CrossfireField {
+  const uint8_t offset;       // offset in the frame (address byte is 0)
+  const uint8_t size;         // big-endian, sign extended
+  const uint8_t sensorIndex;
+  const uint8_t conversion;
+};
+
+// Fields are grouped by frame type, in frame order
+const CrossfireField crossfireFields[] = {
+  // GPS_ID
+  { 3, 4, GPS_LATITUDE_INDEX,     CRSF_CONV_DIV10},
+  { 7, 4, GPS_LONGITUDE_INDEX,    CRSF_CONV_DIV10},
+  {11, 2, GPS_GROUND_SPEED_INDEX, CRSF_CONV_NONE},
+  {13, 2, GPS_HEADING_INDEX,      CRSF_CONV_NONE},
+  {15, 2, GPS_ALTITUDE_INDEX,     CRSF_CONV_ALTITUDE},
+  {17, 1, GPS_SATELLITES_INDEX,   CRSF_CONV_NONE},
+  // CF_VARIO_ID
+  { 3, 2, VERTICAL_SPEED_INDEX,   CRSF_CONV_NONE},
+  // BATTERY_ID
+  { 3, 2, BATT_VOLTAGE_INDEX,     CRSF_CONV_NONE},
+  { 5, 2, BATT_CURRENT_INDEX,     CRSF_CONV_NONE},
+  { 7, 3, BATT_CAPACITY_INDEX,    CRSF_CONV_NONE},
+  {10, 1, BATT_REMAINING_INDEX,   CRSF_CONV_NONE},
+  // LINK_ID
+  { 3, 1, RX_RSSI1_INDEX,         CRSF_CONV_NONE},
+  { 4, 1, RX_RSSI2_INDEX,         CRSF_CONV_NONE},
+  { 5, 1, RX_QUALITY_INDEX,       CRSF_CONV_NONE},
+  { 6, 1, RX_SNR_INDEX,           CRSF_CONV_NONE},
+  { 7, 1, RX_ANTENNA_INDEX,       CRSF_CONV_NONE},
+  { 8, 1, RF_MODE_INDEX,          CRSF_CONV_NONE},
+  { 9, 1, TX_POWER_INDEX,         CRSF_CONV_TX_POWER},
+  {10, 1, TX_RSSI_INDEX,          CRSF_CONV_NONE},
+  {11, 1, TX_QUALITY_INDEX,       CRSF_CONV_NONE},
+  {12, 1, TX_SNR_INDEX,           CRSF_CONV_NONE},
+  // LINK_RX_ID
+  { 4, 1, RX_RSSI_PERC_INDEX,     CRSF_CONV_NONE},
+  { 7, 1, TX_RF_POWER_INDEX,      CRSF_CONV_NONE},
+  // LINK_TX_ID
+  { 4, 1, TX_RSSI_PERC_INDEX,     CRSF_CONV_NONE},
+  { 7, 1, RX_RF_POWER_INDEX,      CRSF_CONV_NONE},
+  { 8, 1, TX_FPS_INDEX,           CRSF_CONV_MUL10},
+  // ATTITUDE_ID
+  { 3, 2, ATTITUDE_PITCH_INDEX,   CRSF_CONV_DIV10},
+  { 5, 2, ATTITUDE_ROLL_INDEX,    CRSF_CONV_DIV10},
+  { 7, 2, ATTITUDE_YAW_INDEX,     CRSF_CONV_DIV10},
+};
+
+struct CrossfireFrameType {
+  const uint8_t id;
+  const uint8_t firstSensor;
+  const uint8_t sensorsCount;
+  const uint8_t firstField;
+  const uint8_t fieldsCount;
+};
+
+// Indexed by CrossfireFrameTypes
+const CrossfireFrameType crossfireFrameTypes[] = {
+  {GPS_ID,         GPS_LATITUDE_INDEX,   6, 0,  6},
+  {CF_VARIO_ID,    VERTICAL_SPEED_INDEX, 1, 6,  1},
+  {BATTERY_ID,     BATT_VOLTAGE_INDEX,   4, 7,  4},
+  {LINK_ID,        RX_RSSI1_INDEX,      10, 11, 10},
+  {LINK_RX_ID,     RX_RSSI_PERC_INDEX,   2, 21, 2},
+  {LINK_TX_ID,     TX_RSSI_PERC_INDEX,   3, 23, 3},
+  {ATTITUDE_ID,    ATTITUDE_PITCH_INDEX, 3, 26, 3},
+  {FLIGHT_MODE_ID, FLIGHT_MODE_INDEX,    1, 0,  0},
+  {RADIO_ID,       UNKNOWN_INDEX,        0, 0,  0},
+};
+
+static_assert(DIM(crossfireFrameTypes) == CRSF_TYPE_OTHER, "Crossfire frame types table mismatch");
+
+CrossfireTelemetryStats crossfireTelemetryStats[NUM_MODULES];
+
+static uint8_t getCrossfireFrameType(uint8_t id)
+{
+  for (uint8_t i = 0; i < DIM(crossfireFrameTypes); i++) {
+    if (crossfireFrameTypes[i].id == id)
+      return i;
+  }
+  return CRSF_TYPE_OTHER;
+}
+
 const CrossfireSensor & getCrossfireSensor(uint8_t id, uint8_t subId)
 {
-  if (id == LINK_ID)
-    return crossfireSensors[RX_RSSI1_INDEX+subId];
-  else if (id == LINK_RX_ID)
-    return crossfireSensors[RX_RSSI_PERC_INDEX+subId];
-  else if (id == LINK_TX_ID)
-    return crossfireSensors[TX_RSSI_PERC_INDEX+subId];
-  else if (id == BATTERY_ID)
-    return crossfireSensors[BATT_VOLTAGE_INDEX+subId];
-  else if (id == GPS_ID)
-    return crossfireSensors[GPS_LATITUDE_INDEX+subId];
-  else if (id == CF_VARIO_ID)
-    return crossfireSensors[VERTICAL_SPEED_INDEX];
-  else if (id == ATTITUDE_ID)
-    return crossfireSensors[ATTITUDE_PITCH_INDEX+subId];
-  else if (id == FLIGHT_MODE_ID)
-    return crossfireSensors[FLIGHT_MODE_INDEX];
-  else
+  uint8_t type = getCrossfireFrameType(id);
+  if (type == CRSF_TYPE_OTHER || crossfireFrameTypes[type].sensorsCount == 0)
     return crossfireSensors[UNKNOWN_INDEX];
+
+  const CrossfireFrameType & frameType = crossfireFrameTypes[type];
+  if (subId >= frameType.sensorsCount)
+    subId = 0;
+  return crossfireSensors[frameType.firstSensor + subId];
 }
 
 void processCrossfireTelemetryValue(uint8_t index, int32_t value)
@@ -95,14 +175,12 @@ bool checkCrossfireTelemetryFrameCRC(uint8_t module)
   return (crc == rxBuffer[len+1]);
 }
 
-template<int N>
-bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
+// Reads a big-endian field in place, a field with all bytes at 0xFF is not set
+static bool getCrossfireTelemetryValue(const uint8_t * byte, uint8_t size, int32_t & value)
 {
-  uint8_t * rxBuffer = getTelemetryRxBuffer(module);
   bool result = false;
-  uint8_t * byte = &rxBuffer[index];
   value = (*byte & 0x80) ? -1 : 0;
-  for (uint8_t i=0; i<N; i++) {
+  for (uint8_t i=0; i<size; i++) {
     value <<= 8;
     if (*byte != 0xff) {
       result = true;
@@ -112,6 +190,61 @@ bool getCrossfireTelemetryValue(uint8_t index, int32_t & value, uint8_t module)
   return result;
 }
 
+static int32_t convertCrossfireTelemetryValue(uint8_t conversion, int32_t value)
+{
+  switch (conversion) {
+    case CRSF_CONV_DIV10:
+      return value / 10;
+
+    case CRSF_CONV_MUL10:
+      return value * 10;
+
+    case CRSF_CONV_ALTITUDE:
+      return value - 1000;
+
+    case CRSF_CONV_TX_POWER:
+    {
+      static const int32_t power_values[] = {0,    10,   25,  100, 500,
+                                             1000, 2000, 250, 50};
+      return ((unsigned)value < DIM(power_values) ? power_values[value] : 0);
+    }
+
+    default:
+      return value;
+  }
+}
+
+static void processCrossfireLinkQuality(int32_t value, uint8_t module)
+{
+  if (value) {
+    telemetryData.rssi.set(value);
+    telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+    telemetryData.telemetryValid |= 1 << module;
+  }
+  else {
+    if (telemetryData.telemetryValid & (1 << module)) {
+      telemetryData.rssi.reset();
+      telemetryStreaming = 0;
+    }
+    telemetryData.telemetryValid &= ~(1 << module);
+  }
+}
+
+static void updateCrossfireTelemetryStats(uint8_t type, uint8_t module)
+{
+  CrossfireTelemetryStats & stats = crossfireTelemetryStats[module];
+  tmr10ms_t now = get_tmr10ms();
+
+  if (now - stats.rateWindowStart >= 100) {
+    memcpy(stats.typeRate, stats.typeCount, sizeof(stats.typeRate));
+    memclear(stats.typeCount, sizeof(stats.typeCount));
+    stats.rateWindowStart = now;
+  }
+
+  stats.frames++;
+  stats.typeCount[type]++;
+}
+
 void processCrossfireTelemetryFrame(uint8_t module)
 {
   uint8_t * rxBuffer = getTelemetryRxBuffer(module);
@@ -119,6 +252,7 @@ void processCrossfireTelemetryFrame(uint8_t module)
 
   if (!checkCrossfireTelemetryFrameCRC(module)) {
     TRACE("[XF] CRC error");
+    crossfireTelemetryStats[module].crcErrors++;
     return;
   }
 
@@ -128,92 +262,30 @@ void processCrossfireTelemetryFrame(uint8_t module)
   }
 
   uint8_t id = rxBuffer[2];
-  int32_t value;
-  switch(id) {
-    case CF_VARIO_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
-        processCrossfireTelemetryValue(VERTICAL_SPEED_INDEX, value);
-      break;
+  uint8_t type = getCrossfireFrameType(id);
+  updateCrossfireTelemetryStats(type, module);
 
-    case GPS_ID:
-      if (getCrossfireTelemetryValue<4>(3, value, module))
-        processCrossfireTelemetryValue(GPS_LATITUDE_INDEX, value/10);
-      if (getCrossfireTelemetryValue<4>(7, value, module))
-        processCrossfireTelemetryValue(GPS_LONGITUDE_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(11, value, module))
-        processCrossfireTelemetryValue(GPS_GROUND_SPEED_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(13, value, module))
-        processCrossfireTelemetryValue(GPS_HEADING_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(15, value, module))
-        processCrossfireTelemetryValue(GPS_ALTITUDE_INDEX,  value - 1000);
-      if (getCrossfireTelemetryValue<1>(17, value, module))
-        processCrossfireTelemetryValue(GPS_SATELLITES_INDEX, value);
-      break;
+  // fields past the end of a short frame are skipped, the CRC byte excluded
+  uint8_t end = rxBuffer[1] + 1;
+  int32_t value;
 
-    case LINK_ID:
-      for (unsigned int i=0; i<=TX_SNR_INDEX; i++) {
-        if (getCrossfireTelemetryValue<1>(3+i, value, module)) {
-          if (i == TX_POWER_INDEX) {
-            static const int32_t power_values[] = {0,    10,   25,  100, 500,
-                                                   1000, 2000, 250, 50};
-            value =
-                ((unsigned)value < DIM(power_values) ? power_values[value] : 0);
-          }
-          processCrossfireTelemetryValue(i, value);
-          if (i == RX_QUALITY_INDEX) {
-            if (value) {
-              telemetryData.rssi.set(value);
-              telemetryStreaming = TELEMETRY_TIMEOUT10ms;
-              telemetryData.telemetryValid |= 1 << module;
-            }
-            else {
-              if (telemetryData.telemetryValid & (1 << module)) {
-                telemetryData.rssi.reset();
-                telemetryStreaming = 0;
-              }
-              telemetryData.telemetryValid &= ~(1 << module);
-            }
-          }
+  const CrossfireFrameType & frameType = crossfireFrameTypes[type];
+  if (type != CRSF_TYPE_OTHER) {
+    const CrossfireField * field = &crossfireFields[frameType.firstField];
+    for (uint8_t i = 0; i < frameType.fieldsCount; i++, field++) {
+      if (field->offset + field->size > end)
+        break;
+      if (getCrossfireTelemetryValue(&rxBuffer[field->offset], field->size, value)) {
+        value = convertCrossfireTelemetryValue(field->conversion, value);
+        processCrossfireTelemetryValue(field->sensorIndex, value);
+        if (field->sensorIndex == RX_QUALITY_INDEX) {
+          processCrossfireLinkQuality(value, module);
         }
       }
-      break;
-
-    case LINK_RX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value, module))
-        processCrossfireTelemetryValue(RX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value, module))
-        processCrossfireTelemetryValue(TX_RF_POWER_INDEX, value);
-      break;
-
-    case LINK_TX_ID:
-      if (getCrossfireTelemetryValue<1>(4, value, module))
-        processCrossfireTelemetryValue(TX_RSSI_PERC_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(7, value, module))
-        processCrossfireTelemetryValue(RX_RF_POWER_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(8, value, module))
-        processCrossfireTelemetryValue(TX_FPS_INDEX, value * 10);
-      break;
-
-    case BATTERY_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
-        processCrossfireTelemetryValue(BATT_VOLTAGE_INDEX, value);
-      if (getCrossfireTelemetryValue<2>(5, value, module))
-        processCrossfireTelemetryValue(BATT_CURRENT_INDEX, value);
-      if (getCrossfireTelemetryValue<3>(7, value, module))
-        processCrossfireTelemetryValue(BATT_CAPACITY_INDEX, value);
-      if (getCrossfireTelemetryValue<1>(10, value, module))
-        processCrossfireTelemetryValue(BATT_REMAINING_INDEX, value);
-      break;
-
-    case ATTITUDE_ID:
-      if (getCrossfireTelemetryValue<2>(3, value, module))
-        processCrossfireTelemetryValue(ATTITUDE_PITCH_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(5, value, module))
-        processCrossfireTelemetryValue(ATTITUDE_ROLL_INDEX, value/10);
-      if (getCrossfireTelemetryValue<2>(7, value, module))
-        processCrossfireTelemetryValue(ATTITUDE_YAW_INDEX, value/10);
-      break;
+    }
+  }
 
+  switch(id) {
     case FLIGHT_MODE_ID:
     {
       const CrossfireSensor & sensor = crossfireSensors[FLIGHT_MODE_INDEX];
@@ -230,9 +302,8 @@ void processCrossfireTelemetryFrame(uint8_t module)
       ) {
         uint32_t update_interval;
         int32_t offset;
-        if (getCrossfireTelemetryValue<4>(6, (int32_t &)update_interval,
-                                          module) &&
-            getCrossfireTelemetryValue<4>(10, offset, module)) {
+        if (getCrossfireTelemetryValue(&rxBuffer[6], 4, (int32_t &)update_interval) &&
+            getCrossfireTelemetryValue(&rxBuffer[10], 4, offset)) {
           // values are in 10th of micro-seconds
           update_interval /= 10;
           offset /= 10;
@@ -245,7 +316,8 @@ void processCrossfireTelemetryFrame(uint8_t module)
 
 #if defined(LUA)
     default:
-      if (luaInputTelemetryFifo && luaInputTelemetryFifo->hasSpace(rxBufferCount-2) ) {
+      if (type == CRSF_TYPE_OTHER && luaInputTelemetryFifo &&
+          luaInputTelemetryFifo->hasSpace(rxBufferCount-2)) {
         for (uint8_t i=1; i<rxBufferCount-1; i++) {
           // destination address and CRC are skipped
           luaInputTelemetryFifo->push(rxBuffer[i]);
@@ -274,12 +346,20 @@ void processCrossfireTelemetryData(uint8_t data, uint8_t module)
 
   if (rxBufferCount == 0 && data != RADIO_ADDRESS && data != UART_SYNC) {
     TRACE("[XF] address 0x%02X error", data);
+    crossfireTelemetryStats[module].malformed++;
     return;
   }
 
   if (rxBufferCount == 1 && (data < 2 || data > TELEMETRY_RX_PACKET_SIZE-2)) {
     TRACE("[XF] length 0x%02X error", data);
-    rxBufferCount = 0;
+    crossfireTelemetryStats[module].malformed++;
+    // the length byte may be the start of the next frame
+    if (data == RADIO_ADDRESS || data == UART_SYNC) {
+      rxBuffer[0] = data;
+    }
+    else {
+      rxBufferCount = 0;
+    }
     return;
   }
 
@@ -288,21 +368,20 @@ void processCrossfireTelemetryData(uint8_t data, uint8_t module)
   }
   else {
     TRACE("[XF] array size %d error", rxBufferCount);
+    crossfireTelemetryStats[module].overruns++;
     rxBufferCount = 0;
   }
 
-  if (rxBufferCount > 4) {
-    uint8_t length = rxBuffer[1];
-    if (length + 2 == rxBufferCount) {
+  // the frame is decoded in place, once its last byte (CRC) is received
+  if (rxBufferCount > 4 && rxBuffer[1] + 2 == rxBufferCount) {
 #if defined(BLUETOOTH)
-      if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
-          bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
-        bluetooth.write(rxBuffer, rxBufferCount);
-      }
-#endif
-      processCrossfireTelemetryFrame(module);
-      rxBufferCount = 0;
+    if (g_eeGeneral.bluetoothMode == BLUETOOTH_TELEMETRY &&
+        bluetooth.state == BLUETOOTH_STATE_CONNECTED) {
+      bluetooth.write(rxBuffer, rxBufferCount);
     }
+#endif
+    processCrossfireTelemetryFrame(module);
+    rxBufferCount = 0;
   }
 }
 
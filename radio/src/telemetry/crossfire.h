@@ -98,7 +98,35 @@ enum CrossfireFrames{
   CRSF_FRAME_MODELID_SENT
 };
 
+// Frame types tracked individually in the parser statistics
+enum CrossfireFrameTypes {
+  CRSF_TYPE_GPS,
+  CRSF_TYPE_VARIO,
+  CRSF_TYPE_BATTERY,
+  CRSF_TYPE_LINK,
+  CRSF_TYPE_LINK_RX,
+  CRSF_TYPE_LINK_TX,
+  CRSF_TYPE_ATTITUDE,
+  CRSF_TYPE_FLIGHT_MODE,
+  CRSF_TYPE_RADIO,
+  CRSF_TYPE_OTHER,
+  CRSF_TYPE_COUNT
+};
+
+struct CrossfireTelemetryStats {
+  uint32_t frames;
+  uint32_t crcErrors;
+  uint32_t malformed;   // bad address or length byte
+  uint32_t overruns;    // frame did not fit into the rx buffer
+  uint16_t typeCount[CRSF_TYPE_COUNT];  // frames in the current 1s window
+  uint16_t typeRate[CRSF_TYPE_COUNT];   // frames during the last 1s window
+  uint32_t rateWindowStart;
+};
+
+extern CrossfireTelemetryStats crossfireTelemetryStats[NUM_MODULES];
+
 void processCrossfireTelemetryData(uint8_t data, uint8_t module);
+void processCrossfireTelemetryFrame(uint8_t module);
 void crossfireSetDefault(int index, uint8_t id, uint8_t subId);
 uint8_t createCrossfireModelIDFrame(uint8_t * frame);
 
@@ -31,6 +31,12 @@
 
 TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
 uint8_t allowNewSensors;
+uint8_t telemetryModelChanges;
+
+void invalidateCalculatedSensors()
+{
+  telemetryModelChanges++;
+}
 
 bool isFaiForbidden(source_t idx)
 {
@@ -302,8 +308,53 @@ void TelemetryItem::per10ms(const TelemetrySensor & sensor)
   }
 }
 
+// Changes counters of the sensors a calculated sensor reads, one per
+// source slot (0 when unused)
+static void getSourcesChanges(const TelemetrySensor & sensor, uint8_t * changes)
+{
+  memset(changes, 0, TELEMETRY_CALC_SOURCES_MAX);
+
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      if (sensor.cell.source)
+        changes[0] = telemetryItems[sensor.cell.source-1].changes;
+      break;
+
+    case TELEM_FORMULA_DIST:
+      if (sensor.dist.gps)
+        changes[0] = telemetryItems[sensor.dist.gps-1].changes;
+      if (sensor.dist.alt)
+        changes[1] = telemetryItems[sensor.dist.alt-1].changes;
+      break;
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+      for (int i=0; i<(sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4); i++) {
+        int8_t source = sensor.calc.sources[i];
+        if (source)
+          changes[i] = telemetryItems[abs(source)-1].changes;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
 void TelemetryItem::eval(const TelemetrySensor & sensor)
 {
+  // the result can only change when a source got a new value or was lost,
+  // or when the sensor settings changed
+  uint8_t newSourcesChanges[TELEMETRY_CALC_SOURCES_MAX];
+  getSourcesChanges(sensor, newSourcesChanges);
+  if (evalModelChanges == telemetryModelChanges && !memcmp(newSourcesChanges, sourcesChanges, sizeof(sourcesChanges)))
+    return;
+  evalModelChanges = telemetryModelChanges;
+  memcpy(sourcesChanges, newSourcesChanges, sizeof(sourcesChanges));
+
   switch (sensor.formula) {
     case TELEM_FORMULA_CELL:
       if (sensor.cell.source) {
@@ -352,7 +403,7 @@ void TelemetryItem::eval(const TelemetrySensor & sensor)
 
     case TELEM_FORMULA_DIST:
       if (sensor.dist.gps) {
-        TelemetryItem gpsItem = telemetryItems[sensor.dist.gps-1];
+        TelemetryItem & gpsItem = telemetryItems[sensor.dist.gps-1];
         TelemetryItem * altItem = nullptr;
         if (!gpsItem.isAvailable()) {
           return;
@@ -28,6 +28,11 @@ constexpr int8_t TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE = -2;
 constexpr int8_t TELEMETRY_SENSOR_TIMEOUT_OLD = -1;
 constexpr int8_t TELEMETRY_SENSOR_TIMEOUT_START = 125; // * 160ms = 20s
 constexpr uint8_t TELEMETRY_SENSOR_TEXT_LENGTH = 16;
+constexpr uint8_t TELEMETRY_CALC_SOURCES_MAX = 4;
+
+// incremented on each model change, calculated sensors are evaluated again
+extern uint8_t telemetryModelChanges;
+void invalidateCalculatedSensors();
 
 class TelemetryItem
 {
@@ -49,6 +54,12 @@ class TelemetryItem
 
     int8_t timeout; // for detection of sensor loss
 
+    uint8_t changes;        // incremented on each new value or loss
+
+    // calculated sensors: model and sources changes when last evaluated
+    uint8_t evalModelChanges;
+    uint8_t sourcesChanges[TELEMETRY_CALC_SOURCES_MAX];
+
     union {
       struct {
         int32_t  offsetAuto;
@@ -88,6 +99,7 @@ class TelemetryItem
     {
       memset(reinterpret_cast<void*>(this), 0, sizeof(TelemetryItem));
       timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
+      evalModelChanges = telemetryModelChanges - 1;
     }
 
     void eval(const TelemetrySensor & sensor);
@@ -125,11 +137,13 @@ class TelemetryItem
     inline void setFresh()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_START;
+      changes++;
     }
 
     inline void setOld()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
+      changes++;
     }
 };
 
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+/*
+ * bench-radio: microbenchmarks for the radio hot paths
+ *
+ * Each benchmark is calibrated so that one sample lasts at least
+ * --min-time ms, then --samples samples are timed and the per-iteration
+ * min / median / mean / stddev are reported, optionally as JSON for
+ * radio/util/bench-compare.py.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define BENCH_DEFAULT_SAMPLES   20
+#define BENCH_DEFAULT_MIN_TIME  10     // ms per sample
+#define BENCH_MAX_ITERATIONS    (1u << 30)
+
+struct BenchOptions
+{
+  unsigned samples = BENCH_DEFAULT_SAMPLES;
+  unsigned minTime = BENCH_DEFAULT_MIN_TIME;
+  const char * filter = nullptr;
+  const char * json = nullptr;
+};
+
+struct BenchResult
+{
+  std::string name;
+  uint32_t iterations;
+  double minNs;
+  double medianNs;
+  double meanNs;
+  double stddevNs;
+};
+
+uint16_t anaInValues[NUM_STICKS + NUM_POTS + NUM_SLIDERS] = { 0 };
+
+uint16_t anaIn(uint8_t chan)
+{
+  if (chan < NUM_STICKS + NUM_POTS + NUM_SLIDERS)
+    return anaInValues[chan];
+  else
+    return 0;
+}
+
+uint16_t getAnalogValue(uint8_t index)
+{
+  return anaIn(index);
+}
+
+void benchResetRadio()
+{
+  generalDefault();
+  g_eeGeneral.templateSetup = 0;
+  memset(anaInValues, 0, sizeof(anaInValues));
+  for (int i = 0; i < NUM_SWITCHES; i++) {
+    simuSetSwitch(i, -1);
+  }
+
+  memset(&g_model, 0, sizeof(g_model));
+  extern uint8_t s_mixer_first_run_done;
+  s_mixer_first_run_done = false;
+  memset(channelOutputs, 0, sizeof(channelOutputs));
+  memset(chans, 0, sizeof(chans));
+  memset(ex_chans, 0, sizeof(ex_chans));
+  memset(act, 0, sizeof(act));
+  memset(swOn, 0, sizeof(swOn));
+  mixerCurrentFlightMode = lastFlightMode = 0;
+  logicalSwitchesReset();
+#if defined(GVARS)
+  invalidateGVarCache();
+#endif
+  setModelDefaults();
+}
+
+static uint64_t timeIterations(Benchmark * benchmark, uint32_t iterations)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    benchmark->run();
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static BenchResult runBenchmark(Benchmark * benchmark, const BenchOptions & options)
+{
+  BenchResult result;
+  result.name = benchmark->getName();
+
+  benchmark->setup();
+
+  // calibration, which is also the warm-up
+  const uint64_t minTime = uint64_t(options.minTime) * 1000000;
+  uint32_t iterations = 1;
+  while (iterations < BENCH_MAX_ITERATIONS) {
+    uint64_t elapsed = timeIterations(benchmark, iterations);
+    if (elapsed >= minTime)
+      break;
+    // aim slightly above the minimum time, at most 10x more each round
+    uint64_t estimate = elapsed ? minTime * 12 / 10 * iterations / elapsed : uint64_t(iterations) * 10;
+    iterations = uint32_t(std::min<uint64_t>(std::max<uint64_t>(estimate, iterations + 1), std::min<uint64_t>(uint64_t(iterations) * 10, BENCH_MAX_ITERATIONS)));
+  }
+  result.iterations = iterations;
+
+  std::vector<double> samples;
+  for (unsigned s = 0; s < options.samples; s++) {
+    samples.push_back(double(timeIterations(benchmark, iterations)) / iterations);
+  }
+
+  std::sort(samples.begin(), samples.end());
+  size_t count = samples.size();
+  result.minNs = samples[0];
+  result.medianNs = (count % 2) ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+  double sum = 0;
+  for (double sample : samples)
+    sum += sample;
+  result.meanNs = sum / count;
+  double variance = 0;
+  for (double sample : samples)
+    variance += (sample - result.meanNs) * (sample - result.meanNs);
+  result.stddevNs = count > 1 ? sqrt(variance / (count - 1)) : 0;
+
+  return result;
+}
+
+static bool writeJson(const char * path, const std::vector<BenchResult> & results, const BenchOptions & options)
+{
+  FILE * out = fopen(path, "w");
+  if (!out) {
+    perror(path);
+    return false;
+  }
+
+  fprintf(out, "{\n");
+  fprintf(out, "  \"flavour\": \"%s\",\n", FLAVOUR);
+  fprintf(out, "  \"samples\": %u,\n", options.samples);
+  fprintf(out, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult & result = results[i];
+    fprintf(out, "    {\"name\": \"%s\", \"iterations\": %u, \"min_ns\": %.2f, \"median_ns\": %.2f, \"mean_ns\": %.2f, \"stddev_ns\": %.2f}%s\n",
+            result.name.c_str(), result.iterations, result.minNs, result.medianNs, result.meanNs, result.stddevNs,
+            i + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+  fclose(out);
+  return true;
+}
+
+static void usage(const char * program)
+{
+  fprintf(stderr, "Usage: %s [-f filter] [-n samples] [-t min_time] [-o results.json] [-l]\n", program);
+  fprintf(stderr, "  -f filter    only run the benchmarks whose name contains filter\n");
+  fprintf(stderr, "  -n samples   timed samples per benchmark (default %d)\n", BENCH_DEFAULT_SAMPLES);
+  fprintf(stderr, "  -t min_time  minimum duration of a sample in ms (default %d)\n", BENCH_DEFAULT_MIN_TIME);
+  fprintf(stderr, "  -o file      write the results as JSON\n");
+  fprintf(stderr, "  -l           list the benchmarks\n");
+}
+
+int main(int argc, char ** argv)
+{
+  BenchOptions options;
+  bool list = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+      options.filter = argv[++i];
+    }
+    else if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      options.samples = std::max(1, atoi(argv[++i]));
+    }
+    else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+      options.minTime = std::max(1, atoi(argv[++i]));
+    }
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+      options.json = argv[++i];
+    }
+    else if (!strcmp(argv[i], "-l")) {
+      list = true;
+    }
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<Benchmark *> benchmarks = Benchmark::registry();
+  std::sort(benchmarks.begin(), benchmarks.end(), [](Benchmark * a, Benchmark * b) {
+    return strcmp(a->getName(), b->getName()) < 0;
+  });
+
+  if (list) {
+    for (Benchmark * benchmark : benchmarks) {
+      printf("%s\n", benchmark->getName());
+    }
+    return 0;
+  }
+
+  simuInit();
+#if !defined(COLORLCD)
+  menuLevel = 0;
+#endif
+  if (g_tmr10ms == 0) {
+    g_tmr10ms = 1;
+  }
+
+  std::vector<BenchResult> results;
+  printf("%-40s %12s %12s %12s %10s\n", "benchmark", "median [ns]", "min [ns]", "stddev [ns]", "iterations");
+  for (Benchmark * benchmark : benchmarks) {
+    if (options.filter && !strstr(benchmark->getName(), options.filter))
+      continue;
+    BenchResult result = runBenchmark(benchmark, options);
+    printf("%-40s %12.1f %12.1f %12.1f %10u\n", result.name.c_str(), result.medianNs, result.minNs, result.stddevNs, result.iterations);
+    fflush(stdout);
+    results.push_back(result);
+  }
+
+  if (options.json && !writeJson(options.json, results, options))
+    return 1;
+
+  return 0;
+}
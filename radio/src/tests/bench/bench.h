@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdint.h>
+#include <vector>
+
+#define SWAP_DEFINED
+#include "opentx.h"
+#include "model_init.h"
+
+/*
+ * Minimal microbenchmark framework, registered like gtest tests:
+ *
+ *   BENCHMARK_F(Mixer, evalMixes)
+ *   {
+ *     evalMixes(1);
+ *   }
+ *
+ * The body is one iteration. setup() of the fixture is called once
+ * before the warm-up and is not timed.
+ */
+class Benchmark
+{
+  public:
+    virtual ~Benchmark() = default;
+
+    virtual void setup()
+    {
+    }
+
+    virtual void run() = 0;
+
+    const char * getName() const
+    {
+      return name;
+    }
+
+    static std::vector<Benchmark *> & registry()
+    {
+      static std::vector<Benchmark *> benchmarks;
+      return benchmarks;
+    }
+
+    struct Registrar
+    {
+      Registrar(const char * name, Benchmark * benchmark)
+      {
+        benchmark->name = name;
+        registry().push_back(benchmark);
+      }
+    };
+
+  protected:
+    const char * name = nullptr;
+};
+
+#define BENCHMARK_F(fixture, test) \
+  class fixture##_##test##_Benchmark: public fixture \
+  { \
+    public: \
+      void run() override; \
+  }; \
+  static fixture##_##test##_Benchmark fixture##_##test##_instance; \
+  static Benchmark::Registrar fixture##_##test##_registrar(#fixture "." #test, &fixture##_##test##_instance); \
+  void fixture##_##test##_Benchmark::run()
+
+// keeps the compiler from optimizing away a result
+template<class T>
+inline void benchKeep(const T & value)
+{
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// fixed-seed pseudo random generator, the same sequence on every run
+class BenchRandom
+{
+  public:
+    explicit BenchRandom(uint32_t seed = 0x2545F491):
+      state(seed)
+    {
+    }
+
+    uint32_t next()
+    {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      return state;
+    }
+
+    int32_t range(int32_t min, int32_t max)
+    {
+      return min + int32_t(next() % uint32_t(max - min + 1));
+    }
+
+  protected:
+    uint32_t state;
+};
+
+#define BENCH_MODEL_SEED  0x5EED0001
+
+extern uint16_t anaInValues[NUM_STICKS + NUM_POTS + NUM_SLIDERS];
+
+void benchResetRadio();
+void benchLoadModel(uint32_t seed);
+
+#endif // _BENCH_H_
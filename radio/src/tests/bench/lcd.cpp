@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+#if defined(COLORLCD)
+#include "gui/colorlcd/fonts.h"
+#endif
+
+static const char benchText[] = "The quick brown fox jumps over the lazy dog";
+
+#if defined(COLORLCD)
+class LcdBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      dc.clear(COLOR_THEME_SECONDARY3);
+    }
+
+  protected:
+    BitmapBuffer dc{BMP_RGB565, LCD_W, LCD_H};
+};
+
+BENCHMARK_F(LcdBenchmark, clear)
+{
+  dc.clear(COLOR_THEME_SECONDARY3);
+  benchKeep(dc);
+}
+
+BENCHMARK_F(LcdBenchmark, drawFilledRect)
+{
+  dc.drawFilledRect(10, 10, LCD_W / 2, LCD_H / 2, SOLID, COLOR_THEME_SECONDARY1);
+  benchKeep(dc);
+}
+
+BENCHMARK_F(LcdBenchmark, drawText)
+{
+  dc.drawText(5, 5, benchText, COLOR_THEME_SECONDARY1);
+  benchKeep(dc);
+}
+
+BENCHMARK_F(LcdBenchmark, drawLine)
+{
+  dc.drawLine(0, 0, LCD_W - 1, LCD_H - 1, SOLID, COLOR_THEME_SECONDARY1);
+  dc.drawLine(0, LCD_H - 1, LCD_W - 1, 0, DOTTED, COLOR_THEME_SECONDARY1);
+  benchKeep(dc);
+}
+
+static void checkFontsLoaded(unsigned count)
+{
+  for (unsigned i = 0; i < FONTS_COUNT; i++) {
+    if ((fontsTable[i] != nullptr) != (i < count || i == FONT_STD_INDEX)) {
+      fprintf(stderr, "Font %u %s\n", i, fontsTable[i] ? "should not be loaded" : "not loaded");
+      exit(1);
+    }
+  }
+}
+
+// cold boot: only the standard font is decompressed
+BENCHMARK_F(LcdBenchmark, loadFonts)
+{
+  unloadFonts();
+  loadFonts();
+  checkFontsLoaded(0);
+}
+
+// what the boot used to cost, all the fonts decompressed
+BENCHMARK_F(LcdBenchmark, loadAllFonts)
+{
+  unloadFonts();
+  loadAllFonts();
+  checkFontsLoaded(FONTS_COUNT);
+}
+#else
+class LcdBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      lcdClear();
+    }
+};
+
+BENCHMARK_F(LcdBenchmark, clear)
+{
+  lcdClear();
+  benchKeep(displayBuf);
+}
+
+BENCHMARK_F(LcdBenchmark, drawFilledRect)
+{
+  lcdDrawSolidFilledRect(4, 4, LCD_W / 2, LCD_H / 2);
+  benchKeep(displayBuf);
+}
+
+BENCHMARK_F(LcdBenchmark, drawText)
+{
+  lcdDrawText(0, 0, benchText);
+  lcdDrawText(0, FH, benchText, SMLSIZE);
+  benchKeep(displayBuf);
+}
+
+BENCHMARK_F(LcdBenchmark, drawLine)
+{
+  lcdDrawLine(0, 0, LCD_W - 1, LCD_H - 1);
+  lcdDrawLine(0, LCD_H - 1, LCD_W - 1, 0, DOTTED);
+  benchKeep(displayBuf);
+}
+#endif
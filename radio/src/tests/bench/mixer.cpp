@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+#if defined(SDCARD_YAML)
+  #include "storage/sdcard_yaml.h"
+  #include "storage/conversions/conversions.h"
+#endif
+
+#define BENCH_CURVES        8
+#define BENCH_LOGICAL_SWS   16
+
+// Fills g_model with a model using most mixer features: two inputs per
+// stick, two mix lines per channel, curves, logical switches, flight modes
+void benchLoadModel(uint32_t seed)
+{
+  BenchRandom random(seed);
+
+  benchResetRadio();
+
+  // curves, alternately standard and custom, 5 to 17 points
+  int8_t * points = g_model.points;
+  for (int i = 0; i < BENCH_CURVES && i < MAX_CURVES; i++) {
+    CurveHeader & curve = g_model.curves[i];
+    int count = 5 + 4 * (i % 4);
+    curve.type = (i % 2) ? CURVE_TYPE_CUSTOM : CURVE_TYPE_STANDARD;
+    curve.points = count - 5;
+    curve.smooth = (i % 3 == 0);
+    for (int p = 0; p < count; p++) {
+      *points++ = random.range(-100, 100);
+    }
+    if (curve.type == CURVE_TYPE_CUSTOM) {
+      for (int p = 1; p < count - 1; p++) {
+        *points++ = getCurveX(count, p);
+      }
+    }
+  }
+  loadCurves();
+
+  // inputs
+  int expo = 0;
+  for (int stick = 0; stick < NUM_STICKS && expo + 1 < MAX_EXPOS; stick++) {
+    ExpoData * line = expoAddress(expo++);
+    line->srcRaw = MIXSRC_FIRST_STICK + stick;
+    line->chn = stick;
+    line->mode = 3;
+    line->weight = 100;
+    line->curve.type = CURVE_REF_EXPO;
+    line->curve.value = random.range(-50, 50);
+    line->swtch = SWSRC_FIRST_SWITCH + 2 * stick;
+
+    line = expoAddress(expo++);
+    line->srcRaw = MIXSRC_FIRST_STICK + stick;
+    line->chn = stick;
+    line->mode = 3;
+    line->weight = random.range(50, 100);
+    line->offset = random.range(-10, 10);
+    line->curve.type = CURVE_REF_CUSTOM;
+    line->curve.value = 1 + random.range(0, BENCH_CURVES - 1);
+  }
+
+  // mixes, two lines per channel, the second one being
+  // a switch, another channel or a logical switch
+  int mix = 0;
+  for (int ch = 0; ch < 16 && ch < MAX_OUTPUT_CHANNELS && mix + 1 < MAX_MIXERS; ch++) {
+    MixData * line = mixAddress(mix++);
+    line->destCh = ch;
+    line->srcRaw = MIXSRC_FIRST_INPUT + (ch % NUM_STICKS);
+    line->weight = random.range(20, 100);
+    line->offset = random.range(-20, 20);
+    if (ch % 3 == 0) {
+      line->curve.type = CURVE_REF_CUSTOM;
+      line->curve.value = 1 + random.range(0, BENCH_CURVES - 1);
+    }
+    else if (ch % 3 == 1) {
+      line->curve.type = CURVE_REF_DIFF;
+      line->curve.value = random.range(-30, 30);
+    }
+    if (ch % 5 == 4) {
+      line->speedUp = 10;
+      line->speedDown = 10;
+    }
+
+    line = mixAddress(mix++);
+    line->destCh = ch;
+    line->mltpx = (ch % 2) ? MLTPX_ADD : MLTPX_MUL;
+    line->weight = random.range(-100, 100);
+    switch (ch % 3) {
+      case 0:
+        line->srcRaw = MIXSRC_FIRST_SWITCH + (ch % NUM_SWITCHES);
+        break;
+      case 1:
+        line->srcRaw = (ch > 0) ? MIXSRC_FIRST_CH + ch - 1 : MIXSRC_MAX;
+        break;
+      default:
+        line->srcRaw = MIXSRC_FIRST_POT + (ch % NUM_POTS);
+        line->swtch = SWSRC_FIRST_LOGICAL_SWITCH + (ch % BENCH_LOGICAL_SWS);
+        break;
+    }
+  }
+
+  // logical switches
+  for (int i = 0; i < BENCH_LOGICAL_SWS && i < MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData * ls = lswAddress(i);
+    switch (i % 6) {
+      case 0:
+        ls->func = LS_FUNC_VPOS;
+        ls->v1 = MIXSRC_FIRST_INPUT + (i % NUM_STICKS);
+        ls->v2 = random.range(-50, 50);
+        break;
+      case 1:
+        ls->func = LS_FUNC_APOS;
+        ls->v1 = MIXSRC_FIRST_STICK + (i % NUM_STICKS);
+        ls->v2 = random.range(0, 80);
+        break;
+      case 2:
+        ls->func = LS_FUNC_AND;
+        ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 2;
+        ls->v2 = SWSRC_FIRST_LOGICAL_SWITCH + i - 1;
+        break;
+      case 3:
+        ls->func = LS_FUNC_GREATER;
+        ls->v1 = MIXSRC_FIRST_CH + (i % 8);
+        ls->v2 = MIXSRC_FIRST_CH + ((i + 1) % 8);
+        break;
+      case 4:
+        ls->func = LS_FUNC_STICKY;
+        ls->v1 = SWSRC_FIRST_LOGICAL_SWITCH + i - 4;
+        ls->v2 = SWSRC_FIRST_SWITCH + (i % NUM_SWITCHES);
+        break;
+      default:
+        ls->func = LS_FUNC_TIMER;
+        ls->v1 = 5;
+        ls->v2 = 5;
+        break;
+    }
+  }
+
+  // flight modes
+  for (int i = 1; i < 4 && i < MAX_FLIGHT_MODES; i++) {
+    g_model.flightModeData[i].swtch = SWSRC_FIRST_SWITCH + 3 * ((i + 2) % NUM_SWITCHES) + 2;
+    g_model.flightModeData[i].fadeIn = 5;
+  }
+
+  // limits
+  for (int ch = 0; ch < 16 && ch < MAX_OUTPUT_CHANNELS; ch++) {
+    LimitData * limit = limitAddress(ch);
+    limit->min = random.range(0, 50) * 10;
+    limit->max = random.range(-50, 0) * 10;
+    limit->revert = (ch % 4 == 3);
+  }
+}
+
+static void moveSticks(BenchRandom & random)
+{
+  g_tmr10ms++;
+  for (int i = 0; i < NUM_STICKS + NUM_POTS; i++) {
+    anaInValues[i] = random.range(-RESX, RESX);
+  }
+}
+
+class MixerBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      benchLoadModel(BENCH_MODEL_SEED);
+      random = BenchRandom();
+      evalMixes(1);
+    }
+
+  protected:
+    BenchRandom random;
+};
+
+BENCHMARK_F(MixerBenchmark, evalMixes)
+{
+  moveSticks(random);
+  evalMixes(1);
+  benchKeep(channelOutputs);
+}
+
+class MixerDefaultModel: public MixerBenchmark
+{
+  public:
+    void setup() override
+    {
+      benchResetRadio();
+      applyDefaultTemplate();
+      random = BenchRandom();
+      evalMixes(1);
+    }
+};
+
+BENCHMARK_F(MixerDefaultModel, evalMixes)
+{
+  moveSticks(random);
+  evalMixes(1);
+  benchKeep(channelOutputs);
+}
+
+#if defined(SDCARD_YAML)
+#if defined(RADIO_TX16S)
+  #define BENCH_FIXTURE           "model_25_tx16s"
+  #define BENCH_FIXTURE_VERSION   220
+#elif defined(PCBX12S)
+  #define BENCH_FIXTURE           "model_23_x12s"
+  #define BENCH_FIXTURE_VERSION   219
+#elif defined(PCBX10) && !defined(RADIO_FAMILY_T16)
+  #define BENCH_FIXTURE           "model_23_x10"
+  #define BENCH_FIXTURE_VERSION   219
+#endif
+#endif
+
+#if defined(BENCH_FIXTURE)
+// the model fixture of the tests, extracted and converted once to YAML in the build directory
+class MixerFixtureModel: public MixerBenchmark
+{
+  public:
+    void setup() override
+    {
+      benchResetRadio();
+      simuFatfsSetPaths(BENCH_BUILD_PATH "/" BENCH_FIXTURE "/", BENCH_BUILD_PATH "/" BENCH_FIXTURE "/");
+      if (readModel("model1.yml", (uint8_t *)&g_model, sizeof(g_model))) {
+        char filename[] = "model1.bin";
+        convertBinModelData(filename, BENCH_FIXTURE_VERSION);
+        if (readModel(filename, (uint8_t *)&g_model, sizeof(g_model))) {
+          fprintf(stderr, "Could not load %s, did the bench_%s_files target run?\n", BENCH_FIXTURE, BENCH_FIXTURE);
+          exit(1);
+        }
+      }
+      postModelLoad(false);
+      simuFatfsSetPaths("", "");
+      random = BenchRandom();
+      evalMixes(1);
+    }
+};
+
+BENCHMARK_F(MixerFixtureModel, evalMixes)
+{
+  moveSticks(random);
+  evalMixes(1);
+  benchKeep(channelOutputs);
+}
+#endif
+
+class CurvesBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      benchLoadModel(BENCH_MODEL_SEED);
+      x = -RESX;
+    }
+
+  protected:
+    int x;
+};
+
+BENCHMARK_F(CurvesBenchmark, applyCustomCurve)
+{
+  for (int i = 0; i < BENCH_CURVES; i++) {
+    benchKeep(applyCustomCurve(x, i));
+  }
+  x = (x >= RESX) ? -RESX : x + 7;
+}
+
+class LogicalSwitchesBenchmark: public MixerBenchmark
+{
+};
+
+BENCHMARK_F(LogicalSwitchesBenchmark, evalLogicalSwitches)
+{
+  moveSticks(random);
+  evalLogicalSwitches();
+  benchKeep(g_tmr10ms);
+}
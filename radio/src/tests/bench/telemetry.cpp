@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "bench.h"
+
+struct BenchSensor
+{
+  uint16_t id;
+  uint8_t unit;
+  uint8_t prec;
+  int32_t min;
+  int32_t max;
+};
+
+static const BenchSensor benchSensors[] = {
+  { RSSI_ID, UNIT_DB, 0, 20, 100 },
+  { VFAS_FIRST_ID, UNIT_VOLTS, 2, 1000, 2520 },
+  { CURR_FIRST_ID, UNIT_AMPS, 1, 0, 800 },
+  { ALT_FIRST_ID, UNIT_METERS, 2, -1000, 50000 },
+  { VARIO_FIRST_ID, UNIT_METERS_PER_SECOND, 2, -500, 500 },
+  { T1_FIRST_ID, UNIT_CELSIUS, 0, 10, 90 },
+  { RPM_FIRST_ID, UNIT_RPMS, 0, 0, 30000 },
+  { FUEL_FIRST_ID, UNIT_PERCENT, 0, 0, 100 },
+};
+
+class TelemetryBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      benchResetRadio();
+      telemetryData.clear();
+      telemetryData.rssi.set(100);
+      for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+        telemetryItems[i].clear();
+      }
+      random = BenchRandom();
+
+      // sensors discovery, not part of the measure
+      allowNewSensors = true;
+      update();
+    }
+
+    void update()
+    {
+      for (const BenchSensor & sensor: benchSensors) {
+        setTelemetryValue(PROTOCOL_TELEMETRY_FRSKY_SPORT, sensor.id, 0, 0, random.range(sensor.min, sensor.max), sensor.unit, sensor.prec);
+      }
+    }
+
+  protected:
+    BenchRandom random;
+};
+
+BENCHMARK_F(TelemetryBenchmark, setTelemetryValue)
+{
+  update();
+  benchKeep(telemetryItems);
+}
+
+#if defined(CROSSFIRE)
+uint8_t createCrossfireChannelsFrame(uint8_t * frame, int16_t * pulses);
+
+class CrossfireBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      BenchRandom random;
+      for (int16_t & value: pulses) {
+        value = random.range(-1024, 1024);
+      }
+      getTelemetryRxBufferCount(EXTERNAL_MODULE) = 0;
+    }
+
+  protected:
+    int16_t pulses[MAX_OUTPUT_CHANNELS];
+    uint8_t frame[CROSSFIRE_FRAME_MAXLEN];
+};
+
+BENCHMARK_F(CrossfireBenchmark, createChannelsFrame)
+{
+  pulses[0] = (pulses[0] >= 1024) ? -1024 : pulses[0] + 1;
+  benchKeep(createCrossfireChannelsFrame(frame, pulses));
+}
+
+BENCHMARK_F(CrossfireBenchmark, telemetryParser)
+{
+  // link statistics frame
+  static const uint8_t linkFrame[] = { 0xEA, 0x0C, 0x14, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x03, 0x00, 0x00, 0x00, 0xF4 };
+  for (uint8_t byte: linkFrame) {
+    processCrossfireTelemetryData(byte, EXTERNAL_MODULE);
+  }
+  benchKeep(telemetryItems);
+}
+#endif
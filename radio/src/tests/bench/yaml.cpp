@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <string>
+#include "bench.h"
+
+#if defined(SDCARD_YAML)
+#include "storage/yaml/yaml_tree_walker.h"
+#include "storage/yaml/yaml_parser.h"
+#include "storage/yaml/yaml_datastructs.h"
+
+static bool appendYaml(void * opaque, const char * str, size_t len)
+{
+  static_cast<std::string *>(opaque)->append(str, len);
+  return true;
+}
+
+class YamlBenchmark: public Benchmark
+{
+  public:
+    void setup() override
+    {
+      benchLoadModel(BENCH_MODEL_SEED);
+      yaml.clear();
+      YamlTreeWalker tree;
+      tree.reset(get_modeldata_nodes(), (uint8_t *)&g_model);
+      tree.generate(appendYaml, &yaml);
+    }
+
+  protected:
+    std::string yaml;
+    ModelData model;
+};
+
+BENCHMARK_F(YamlBenchmark, generateModel)
+{
+  std::string output;
+  output.reserve(yaml.size());
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t *)&g_model);
+  tree.generate(appendYaml, &output);
+  benchKeep(output);
+}
+
+BENCHMARK_F(YamlBenchmark, parseModel)
+{
+  YamlTreeWalker tree;
+  tree.reset(get_modeldata_nodes(), (uint8_t *)&model);
+  memset(&model, 0, sizeof(model));
+
+  YamlParser parser;
+  parser.init(YamlTreeWalker::get_parser_calls(), &tree);
+  parser.parse(yaml.data(), yaml.size());
+  benchKeep(model);
+}
+#endif
@@ -44,5 +44,39 @@ TEST(Crossfire, crc8)
   uint8_t crc = crc8(&frame[2], frame[1]-1);
   ASSERT_EQ(frame[frame[1]+1], crc);
 }
+
+TEST(Crossfire, telemetryParser)
+{
+  uint8_t frame[] = { 0xEA, 0x0C, 0x14, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x01, 0x03, 0x00, 0x00, 0x00, 0xF4 };
+  CrossfireTelemetryStats & stats = crossfireTelemetryStats[EXTERNAL_MODULE];
+
+  memclear(&stats, sizeof(stats));
+  getTelemetryRxBufferCount(EXTERNAL_MODULE) = 0;
+
+  // garbage before the frame is skipped
+  processCrossfireTelemetryData(0x55, EXTERNAL_MODULE);
+  for (uint8_t byte: frame) {
+    processCrossfireTelemetryData(byte, EXTERNAL_MODULE);
+  }
+  EXPECT_EQ(1u, stats.malformed);
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_EQ(1, stats.typeCount[CRSF_TYPE_LINK]);
+
+  // a sync byte received in place of the length starts a new frame
+  processCrossfireTelemetryData(UART_SYNC, EXTERNAL_MODULE);
+  for (uint8_t byte: frame) {
+    processCrossfireTelemetryData(byte, EXTERNAL_MODULE);
+  }
+  EXPECT_EQ(2u, stats.malformed);
+  EXPECT_EQ(2u, stats.frames);
+
+  frame[sizeof(frame) - 1] ^= 0xFF;
+  for (uint8_t byte: frame) {
+    processCrossfireTelemetryData(byte, EXTERNAL_MODULE);
+  }
+  EXPECT_EQ(1u, stats.crcErrors);
+  EXPECT_EQ(2u, stats.frames);
+  EXPECT_EQ(0, getTelemetryRxBufferCount(EXTERNAL_MODULE));
+}
 #endif
 
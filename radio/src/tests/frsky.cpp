@@ -497,3 +497,72 @@ TEST(FrSkySPORT, frskyCurrent)
   EXPECT_EQ(telemetryItems[0].valueMax, 505);
 }
 
+
+TEST(Telemetry, CalculatedSensorOnlyEvaluatedOnSourceChange)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+
+  g_model.telemetrySensors[0].init("A", UNIT_VOLTS, 2);
+  g_model.telemetrySensors[1].init("B", UNIT_VOLTS, 2);
+  TelemetrySensor & sum = g_model.telemetrySensors[2];
+  sum.init("Sum", UNIT_VOLTS, 2);
+  sum.type = TELEM_TYPE_CALCULATED;
+  sum.formula = TELEM_FORMULA_ADD;
+  sum.calc.sources[0] = 1;
+  sum.calc.sources[1] = 2;
+
+  telemetryItems[0].setValue(g_model.telemetrySensors[0], 400, UNIT_VOLTS, 2);
+  telemetryItems[1].setValue(g_model.telemetrySensors[1], 350, UNIT_VOLTS, 2);
+  telemetryItems[2].eval(sum);
+  EXPECT_EQ(telemetryItems[2].value, 750);
+
+  // sources unchanged: the previous result is kept
+  telemetryItems[0].value = 0;
+  telemetryItems[2].eval(sum);
+  EXPECT_EQ(telemetryItems[2].value, 750);
+
+  telemetryItems[1].setValue(g_model.telemetrySensors[1], 300, UNIT_VOLTS, 2);
+  telemetryItems[2].eval(sum);
+  EXPECT_EQ(telemetryItems[2].value, 300);
+
+  telemetryItems[0].setOld();
+  telemetryItems[2].eval(sum);
+  EXPECT_TRUE(telemetryItems[2].isOld());
+}
+
+TEST(Telemetry, CalculatedSensorEvaluatedOnModelChange)
+{
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+
+  g_model.telemetrySensors[0].init("A", UNIT_VOLTS, 2);
+  g_model.telemetrySensors[1].init("B", UNIT_VOLTS, 2);
+  TelemetrySensor & sum = g_model.telemetrySensors[2];
+  sum.init("Sum", UNIT_VOLTS, 2);
+  sum.type = TELEM_TYPE_CALCULATED;
+  sum.formula = TELEM_FORMULA_ADD;
+  sum.calc.sources[0] = 1;
+  sum.calc.sources[1] = 2;
+
+  telemetryItems[0].setValue(g_model.telemetrySensors[0], 400, UNIT_VOLTS, 2);
+  telemetryItems[1].setValue(g_model.telemetrySensors[1], 350, UNIT_VOLTS, 2);
+  telemetryItems[2].eval(sum);
+  EXPECT_EQ(telemetryItems[2].value, 750);
+
+  // formula edited, the sources didn't change
+  sum.formula = TELEM_FORMULA_MAX;
+  storageDirty(EE_MODEL);
+  telemetryItems[2].eval(sum);
+  EXPECT_EQ(telemetryItems[2].value, 400);
+
+  // the changes of both sources add up to 256, they are still seen
+  telemetryItems[0].setValue(g_model.telemetrySensors[0], 100, UNIT_VOLTS, 2);
+  for (int i = 0; i < 255; i++) {
+    telemetryItems[1].setValue(g_model.telemetrySensors[1], 350, UNIT_VOLTS, 2);
+  }
+  telemetryItems[2].eval(sum);
+  EXPECT_EQ(telemetryItems[2].value, 350);
+}
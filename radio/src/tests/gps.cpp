@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#if defined(INTERNAL_GPS)
+extern Fifo<uint8_t, 64> gpsTxFifo;
+
+// the simulated USART doesn't send anything, what the parser sends to the
+// receiver would stay in the TX fifo
+static void gpsReset()
+{
+  memset(&gpsData, 0, sizeof(gpsData));
+  gpsTxFifo.clear();
+}
+
+static void gpsFeed(const char * sentence)
+{
+  while (*sentence) {
+    gpsNewFrame(*sentence++);
+  }
+}
+
+static void gpsFeedUBX(uint8_t msgClass, uint8_t msgId, const uint8_t * payload, uint16_t length)
+{
+  uint8_t header[] = { msgClass, msgId, uint8_t(length), uint8_t(length >> 8) };
+  uint8_t ckA = 0, ckB = 0;
+
+  gpsNewFrame(0xB5);
+  gpsNewFrame(0x62);
+  for (uint8_t byte: header) {
+    ckA += byte;
+    ckB += ckA;
+    gpsNewFrame(byte);
+  }
+  for (uint16_t i = 0; i < length; i++) {
+    ckA += payload[i];
+    ckB += ckA;
+    gpsNewFrame(payload[i]);
+  }
+  gpsNewFrame(ckA);
+  gpsNewFrame(ckB);
+}
+
+static void gpsPutInt32(uint8_t * p, int32_t value)
+{
+  for (uint8_t i = 0; i < 4; i++) {
+    p[i] = uint32_t(value) >> (8 * i);
+  }
+}
+
+TEST(Gps, nmeaGGA)
+{
+  gpsReset();
+
+  gpsFeed("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  EXPECT_EQ(gpsData.fix, 1);
+  EXPECT_EQ(gpsData.latitude, 48117300);
+  EXPECT_EQ(gpsData.longitude, 11516666);
+  EXPECT_EQ(gpsData.numSat, 8);
+  EXPECT_EQ(gpsData.hdop, 90);
+  EXPECT_EQ(gpsData.altitude, 545);
+  EXPECT_EQ(gpsData.packetCount, 1u);
+  EXPECT_EQ(gpsData.errorCount, 0u);
+}
+
+TEST(Gps, nmeaRMC)
+{
+  gpsReset();
+
+  gpsFeed("$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n");
+  EXPECT_EQ(gpsData.speed, 1152);
+  EXPECT_EQ(gpsData.groundCourse, 844);
+  EXPECT_EQ(gpsData.packetCount, 1u);
+}
+
+TEST(Gps, nmeaBadChecksum)
+{
+  gpsReset();
+
+  gpsFeed("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*48\r\n");
+  EXPECT_EQ(gpsData.fix, 0);
+  EXPECT_EQ(gpsData.latitude, 0);
+  EXPECT_EQ(gpsData.errorCount, 1u);
+}
+
+TEST(Gps, ubxNavPvt)
+{
+  gpsReset();
+
+  uint8_t pvt[92] = {0};
+  pvt[20] = 3;    // 3D fix
+  pvt[21] = 0x01; // gnssFixOK
+  pvt[23] = 12;   // numSV
+  gpsPutInt32(&pvt[24], 115166660);   // lon
+  gpsPutInt32(&pvt[28], -481173000);  // lat
+  gpsPutInt32(&pvt[36], 545400);      // hMSL
+  gpsPutInt32(&pvt[60], 11520);       // gSpeed
+  gpsPutInt32(&pvt[64], 8440000);     // headMot
+  gpsFeedUBX(0x01, 0x07, pvt, sizeof(pvt));
+
+  EXPECT_EQ(gpsData.protocol, GPS_PROTOCOL_UBX);
+  EXPECT_EQ(gpsData.fix, 1);
+  EXPECT_EQ(gpsData.latitude, -48117300);
+  EXPECT_EQ(gpsData.longitude, 11516666);
+  EXPECT_EQ(gpsData.numSat, 12);
+  EXPECT_EQ(gpsData.altitude, 545);
+  EXPECT_EQ(gpsData.speed, 1152);
+  EXPECT_EQ(gpsData.groundCourse, 844);
+
+  uint8_t dop[18] = {0};
+  dop[6] = 250;   // pDOP, not used
+  dop[12] = 150;  // hDOP
+  gpsFeedUBX(0x01, 0x04, dop, sizeof(dop));
+  EXPECT_EQ(gpsData.hdop, 150);
+
+  // positions come from NAV-PVT, NMEA ones are ignored
+  gpsFeed("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  EXPECT_EQ(gpsData.latitude, -48117300);
+  EXPECT_EQ(gpsData.numSat, 12);
+  EXPECT_EQ(gpsData.errorCount, 0u);
+}
+
+TEST(Gps, ubxBadChecksum)
+{
+  gpsReset();
+
+  uint8_t pvt[92] = {0};
+  pvt[20] = 3;
+  pvt[21] = 0x01;
+  pvt[23] = 12;
+  const uint8_t header[] = { 0xB5, 0x62, 0x01, 0x07, sizeof(pvt), 0 };
+  for (uint8_t byte: header) {
+    gpsNewFrame(byte);
+  }
+  for (uint8_t byte: pvt) {
+    gpsNewFrame(byte);
+  }
+  gpsNewFrame(0);
+  gpsNewFrame(0);
+
+  EXPECT_EQ(gpsData.numSat, 0);
+  EXPECT_EQ(gpsData.errorCount, 1u);
+
+  // the parser is back in sync for the next NMEA sentence
+  gpsFeed("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  EXPECT_EQ(gpsData.numSat, 8);
+}
+TEST(Gps, ubxCorruptedLength)
+{
+  gpsReset();
+
+  // a byte lost in the header, the length is read from the payload
+  const uint8_t header[] = { 0xB5, 0x62, 0x01, 0x07, 0xFF, 0xFF };
+  for (uint8_t byte: header) {
+    gpsNewFrame(byte);
+  }
+  EXPECT_EQ(gpsData.errorCount, 1u);
+
+  gpsFeed("$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n");
+  EXPECT_EQ(gpsData.numSat, 8);
+  EXPECT_EQ(gpsData.latitude, 48117300);
+}
+#endif
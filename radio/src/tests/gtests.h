@@ -69,6 +69,9 @@ inline void MODEL_RESET()
   s_mixer_first_run_done = false;
   evalMixes(1);  // this is needed to reset fp_act
   lastFlightMode = 255;
+#if defined(GVARS)
+  invalidateGVarCache();
+#endif
 }
 
 inline void MIXER_RESET()
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <math.h>
+#include "gtests.h"
+#include "tilt_filter.h"
+
+// 2000dps full scale (70mdps/LSB), 16g full scale (2049 LSB/g), 104Hz
+#define TEST_SAMPLE_RATE   104
+#define TEST_GYRO_LSB      0.070
+#define TEST_ACC_LSB       2049
+#define TEST_GYRO_GAIN     (uint32_t)(((uint64_t)70 * TILT_PI << 16) / (180 * 1000 * TEST_SAMPLE_RATE))
+
+static int16_t tiltDegrees(const TiltFilter & filter)
+{
+  return round(filter.angle() * 180.0 / RESX);
+}
+
+// feed one sample of a rotation around the filter axis
+static void updateFilter(TiltFilter & filter, double angle, double rate, double noise = 0)
+{
+  double rad = angle * M_PI / 180;
+  filter.update(round(rate / TEST_GYRO_LSB), round((sin(rad) + noise) * TEST_ACC_LSB), round(cos(rad) * TEST_ACC_LSB), true);
+}
+
+TEST(TiltFilter, atan2)
+{
+  for (int deg = -179; deg <= 180; deg++) {
+    double rad = deg * M_PI / 180;
+    int32_t result = TiltFilter::atan2(round(sin(rad) * TEST_ACC_LSB), round(cos(rad) * TEST_ACC_LSB));
+    EXPECT_NEAR(deg, result * 180.0 / TILT_PI, 0.3);
+  }
+}
+
+TEST(TiltFilter, staticTilt)
+{
+  TiltFilter filter(TEST_GYRO_GAIN);
+  for (int i = 0; i < TEST_SAMPLE_RATE; i++) {
+    updateFilter(filter, 30, 0);
+  }
+  EXPECT_EQ(30, tiltDegrees(filter));
+}
+
+TEST(TiltFilter, gyroIntegration)
+{
+  // accelerometer ignored (e.g. while under acceleration), 90deg/s for 0.5s
+  TiltFilter filter(TEST_GYRO_GAIN);
+  updateFilter(filter, 0, 0);
+  for (int i = 0; i < TEST_SAMPLE_RATE / 2; i++) {
+    filter.update(round(90 / TEST_GYRO_LSB), 0, 0, false);
+  }
+  EXPECT_NEAR(45, tiltDegrees(filter), 1);
+}
+
+TEST(TiltFilter, rotationWithoutLag)
+{
+  // 180deg/s rotation, the output follows the gyro and not the accelerometer
+  TiltFilter filter(TEST_GYRO_GAIN);
+  double angle = -45;
+  updateFilter(filter, angle, 0);
+  for (int i = 0; i < TEST_SAMPLE_RATE / 2; i++) {
+    angle += 180.0 / TEST_SAMPLE_RATE;
+    updateFilter(filter, angle, 180);
+  }
+  EXPECT_NEAR(angle, tiltDegrees(filter), 1);
+}
+
+TEST(TiltFilter, vibrationNoise)
+{
+  // +/-0.3g vibration on the accelerometer, the gyro is clean
+  TiltFilter filter(TEST_GYRO_GAIN);
+  updateFilter(filter, 10, 0);
+  int16_t minimum = 180, maximum = -180;
+  for (int i = 0; i < 2 * TEST_SAMPLE_RATE; i++) {
+    updateFilter(filter, 10, 0, (i & 1) ? 0.3 : -0.3);
+    minimum = min(minimum, filter.angle());
+    maximum = max(maximum, filter.angle());
+  }
+  EXPECT_LE((maximum - minimum) * 180 / RESX, 1);
+  EXPECT_NEAR(10, tiltDegrees(filter), 1);
+}
+
+TEST(TiltFilter, wrapAround)
+{
+  TiltFilter filter(TEST_GYRO_GAIN);
+  double angle = 170;
+  updateFilter(filter, angle, 0);
+  for (int i = 0; i < TEST_SAMPLE_RATE / 4; i++) {
+    angle += 90.0 / TEST_SAMPLE_RATE;
+    updateFilter(filter, angle, 90);
+  }
+  EXPECT_NEAR(angle - 360, tiltDegrees(filter), 1);
+}
@@ -204,7 +204,7 @@ TEST(Lcd_colorlcd, transparency)
 #if 0
 TEST(Lcd_colorlcd, fonts)
 {
-  loadFonts();
+  loadAllFonts();
 
   BitmapBuffer dc(BMP_RGB565, LCD_W, LCD_H);
   dc.clear(COLOR_THEME_SECONDARY3);
@@ -228,6 +228,46 @@ TEST(Lcd_colorlcd, fonts)
 }
 #endif
 
+TEST(Lcd_colorlcd, fontsLoadedOnDemand)
+{
+  unloadFonts();
+  loadFonts();
+  for (unsigned i = 0; i < FONTS_COUNT; i++) {
+    if (i == FONT_STD_INDEX)
+      EXPECT_NE(nullptr, fontsTable[i]);
+    else
+      EXPECT_EQ(nullptr, fontsTable[i]);
+  }
+
+  // the size of a font is known without decompressing it
+  EXPECT_EQ(fontspecsTable[FONT_XL_INDEX][0], getFontHeight(FONT(XL)));
+  EXPECT_GT(getTextWidth("The quick", 0, FONT(XL)), 0);
+  EXPECT_EQ(nullptr, fontsTable[FONT_XL_INDEX]);
+
+  const uint8_t * font = loadFont(FONT_XL_INDEX);
+  ASSERT_NE(nullptr, font);
+  EXPECT_EQ(font, fontsTable[FONT_XL_INDEX]);
+  EXPECT_EQ(font, loadFont(FONT_XL_INDEX));
+
+  loadAllFonts();
+  for (unsigned i = 0; i < FONTS_COUNT; i++) {
+    EXPECT_NE(nullptr, fontsTable[i]);
+  }
+
+  unloadFonts();
+  loadFonts();
+}
+
+TEST(Lcd_colorlcd, textWidth)
+{
+  EXPECT_EQ(0, getTextWidth("", 0, FONT(STD)));
+  EXPECT_EQ(getTextWidth("The", 0, FONT(STD)), getTextWidth("The quick", 3, FONT(STD)));
+  EXPECT_EQ(getTextWidth("The quick", 0, FONT(STD)),
+            getTextWidth("The", 0, FONT(STD)) + getTextWidth(" quick", 0, FONT(STD)));
+  EXPECT_EQ(getTextWidth("The", 0, FONT(STD)), getTextWidth("T\x01he", 0, FONT(STD)));
+  EXPECT_LT(getTextWidth("The quick", 0, FONT(XS)), getTextWidth("The quick", 0, FONT(XL)));
+}
+
 TEST(Lcd_colorlcd, clipping)
 {
   loadFonts();
@@ -164,4 +164,27 @@ TEST(Lua, testModelInputs)
 
 }
 
+#if defined(LUA_ARENA_SIZE)
+TEST(Lua, testArenaAccounting)
+{
+  extern lua_State * lsScripts;
+  luaInit();
+  EXPECT_EQ(0U, luaArenaGetUsage(0));
+
+  luaArenaSetOwner(0);
+  luaExecStr("big = {} for i = 1, 200 do big[i] = 'item' .. i end");
+  luaExecStr("large = string.rep('x', 4000)");
+  luaArenaSetOwner(LUA_ARENA_OWNER_SYSTEM);
+
+  uint32_t used = luaArenaGetUsage(0);
+  EXPECT_GT(used, 200U * 16 + 4000);
+  EXPECT_EQ(0U, luaArenaGetUsage(1));
+
+  // freed blocks are credited to their owner, whoever frees them
+  luaExecStr("big = nil large = nil");
+  luaDoGc(lsScripts, true);
+  EXPECT_LT(luaArenaGetUsage(0), used / 4);
+}
+#endif
+
 #endif   // #if defined(LUA)
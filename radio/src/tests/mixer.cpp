@@ -822,6 +822,155 @@ TEST_F(MixerTest, flightModeOverflow)
   CHECK_FLIGHT_MODE_TRANSITION(0, 1000, 1024, 1024);
 }
 
+// applyLimits() as it was before the limits were computed in batches
+static int16_t applyLimitsReference(uint8_t channel, int32_t value)
+{
+  LimitData * lim = limitAddress(channel);
+
+  if (lim->curve) {
+    if (lim->curve > 0)
+      value = 256 * applyCustomCurve(value/256, lim->curve-1);
+    else
+      value = 256 * applyCustomCurve(-value/256, -lim->curve-1);
+  }
+
+  int16_t ofs   = LIMIT_OFS_RESX(lim);
+  int16_t lim_p = LIMIT_MAX_RESX(lim);
+  int16_t lim_n = LIMIT_MIN_RESX(lim);
+
+  if (ofs > lim_p) ofs = lim_p;
+  if (ofs < lim_n) ofs = lim_n;
+
+  value = limit(int32_t(-RESXl*256), value, int32_t(RESXl*256));
+
+  if (value) {
+    int16_t tmp;
+#if defined(PPM_LIMITS_SYMETRICAL)
+    if (lim->symetrical)
+      tmp = (value > 0) ? (lim_p) : (-lim_n);
+    else
+#endif
+      tmp = (value > 0) ? (lim_p - ofs) : (-lim_n + ofs);
+    value = (int32_t) value * tmp;
+
+#ifdef CORRECT_NEGATIVE_SHIFTS
+    int8_t sign = (value<0?1:0);
+    value -= sign;
+    tmp = value>>16;
+    tmp >>= 2;
+    tmp += sign;
+#else
+    tmp = value>>16;
+    tmp >>= 2;
+#endif
+
+    ofs += tmp;
+  }
+
+  if (ofs > lim_p)
+    ofs = lim_p;
+  if (ofs < lim_n)
+    ofs = lim_n;
+  if (lim->revert)
+    ofs = -ofs;
+
+  return ofs;
+}
+
+static void setRandomLimits(LimitData * lim)
+{
+  lim->min = rand() % 1001 - 500;
+  lim->max = rand() % 1001 - 500;
+  lim->offset = rand() % 1801 - 900;
+  lim->symetrical = rand() % 2;
+  lim->revert = rand() % 2;
+}
+
+TEST_F(MixerTest, applyLimitsMatchesReference)
+{
+  srand(0);
+  for (int n = 0; n < 2000; n++) {
+    uint8_t channel = rand() % MAX_OUTPUT_CHANNELS;
+    setRandomLimits(&g_model.limitData[channel]);
+    for (int i = 0; i < 100; i++) {
+      // beyond +/-100% to check the clamp too
+      int32_t value = rand() % (RESX * 256 * 6 + 1) - RESX * 256 * 3;
+      ASSERT_EQ(applyLimitsReference(channel, value), applyLimits(channel, value))
+        << "channel " << int(channel) << " value " << value;
+    }
+    ASSERT_EQ(applyLimitsReference(channel, 0), applyLimits(channel, 0));
+  }
+}
+
+TEST_F(MixerTest, evalMixesLimitsMatchReference)
+{
+  srand(1);
+  for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+    g_model.mixData[i].destCh = i;
+    g_model.mixData[i].mltpx = MLTPX_REPL;
+    g_model.mixData[i].srcRaw = MIXSRC_Rud + i % NUM_STICKS;
+    g_model.mixData[i].weight = rand() % 501 - 250;
+  }
+
+  for (int n = 0; n < 200; n++) {
+    for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+      setRandomLimits(&g_model.limitData[i]);
+    }
+    for (uint8_t i = 0; i < NUM_STICKS; i++) {
+      anaInValues[i] = rand() % (2 * RESX + 1) - RESX;
+    }
+    evalMixes(1);
+    for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
+      ASSERT_EQ(applyLimitsReference(i, chans[i]), channelOutputs[i]) << "channel " << int(i);
+    }
+  }
+}
+
+#if defined(GVARS)
+TEST_F(MixerTest, gvarFlightModeLinks)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  setModelDefaults();
+  g_model.flightModeData[0].gvars[0] = 50;
+  EXPECT_EQ(50, getGVarValue(0, 2));
+
+  // FM2 gets its own value
+  SET_GVAR_VALUE(0, 2, 20);
+  EXPECT_EQ(20, getGVarValue(0, 2));
+  EXPECT_EQ(50, getGVarValue(0, 1));
+
+  // FM1 now uses the FM2 value
+  g_model.flightModeData[1].gvars[0] = GVAR_MAX + 2;
+  storageDirty(EE_MODEL);
+  EXPECT_EQ(20, getGVarValue(0, 1));
+  EXPECT_EQ(-20, getGVarValue(-1, 1));
+  EXPECT_EQ(2, getGVarFlightMode(1, 0));
+}
+
+TEST_F(MixerTest, gvarValuesFollowEdits)
+{
+  SYSTEM_RESET();
+  MODEL_RESET();
+  setModelDefaults();
+  g_model.mixData[0].destCh = 0;
+  g_model.mixData[0].srcRaw = MIXSRC_MAX;
+  g_model.mixData[0].weight = -GV1_LARGE;  // GV1
+
+  SET_GVAR_VALUE(0, 0, 50);
+  evalMixes(1);
+  EXPECT_EQ(50, getValue(MIXSRC_GVAR1));
+  EXPECT_EQ(chans[0], CHANNEL_MAX/2);
+
+  // changed between two mixer ticks (special function, Lua)
+  SET_GVAR_VALUE(0, 0, 100);
+  EXPECT_EQ(100, getValue(MIXSRC_GVAR1));
+  EXPECT_EQ(100, getGVarValue(0, 1));
+  evalMixes(1);
+  EXPECT_EQ(chans[0], CHANNEL_MAX);
+}
+#endif
+
 TEST_F(TrimsTest, throttleTrimWithCrossTrims)
 {
   g_model.thrTrim = 1;
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include <deque>
+#include <vector>
+#include "gtests.h"
+#include "location.h"
+
+#if defined(MULTIMODULE) && !defined(DISABLE_MULTI_UPDATE)
+
+#include "io/multi_firmware_update.h"
+#include "io/stk500.h"
+
+#define TEST_PAGE_SIZE  128
+#define TEST_FILE_SIZE  (3 * TEST_PAGE_SIZE + 40)
+#define TEST_FILE_NAME  "multi_update_test.bin"
+
+struct ProgrammedPage {
+  uint32_t address;
+  std::vector<uint8_t> data;
+  uint32_t filePosAtAnswer;
+};
+
+// STK500 bootloader answering the pages it receives, optionally failing one of them
+class LoopbackUpdateDriver: public MultiFirmwareUpdateDriver
+{
+  public:
+    explicit LoopbackUpdateDriver(FIL * file, int failedPage = -1):
+      file(file),
+      failedPage(failedPage)
+    {
+    }
+
+    const char * writePages(uint16_t pageSize, uint32_t writeOffset) const
+    {
+      return MultiFirmwareUpdateDriver::writePages(file, pageSize, writeOffset, "test", onProgress);
+    }
+
+    mutable std::vector<ProgrammedPage> pages;
+
+  protected:
+    FIL * file;
+    int failedPage;
+    mutable std::vector<uint8_t> command;
+    mutable std::deque<uint8_t> answer;
+    mutable uint32_t address = 0;
+    mutable bool pageAnswerPending = false;
+
+    static void onProgress(const char *, const char *, int, int)
+    {
+    }
+
+    void moduleOn() const override
+    {
+    }
+
+    void init(bool inverted) const override
+    {
+    }
+
+    bool getByte(uint8_t & byte) const override
+    {
+      if (pageAnswerPending) {
+        pages.back().filePosAtAnswer = file->fptr;
+        pageAnswerPending = false;
+      }
+      if (answer.empty())
+        return false;
+      byte = answer.front();
+      answer.pop_front();
+      return true;
+    }
+
+    void sendByte(uint8_t byte) const override
+    {
+      command.push_back(byte);
+      if (command[0] == STK_LOAD_ADDRESS && command.size() == 4) {
+        address = command[1] + (command[2] << 8);
+        answer.push_back(STK_INSYNC);
+        answer.push_back(STK_OK);
+        command.clear();
+      }
+      else if (command[0] == STK_PROG_PAGE && command.size() >= 3 && command.size() == 5u + ((command[1] << 8) + command[2])) {
+        pages.push_back({address, std::vector<uint8_t>(command.begin() + 4, command.end() - 1), 0});
+        pageAnswerPending = true;
+        if (int(pages.size()) - 1 != failedPage) {
+          answer.push_back(STK_INSYNC);
+          answer.push_back(STK_OK);
+        }
+        command.clear();
+      }
+    }
+
+    void clear() const override
+    {
+      answer.clear();
+    }
+};
+
+class MultiUpdateTest: public testing::Test
+{
+  protected:
+    uint8_t content[TEST_FILE_SIZE];
+    FIL file;
+
+    void SetUp() override
+    {
+      for (unsigned i = 0; i < TEST_FILE_SIZE; i++) {
+        content[i] = 1 + i * 7;
+      }
+      FILE * fp = fopen(TESTS_BUILD_PATH "/" TEST_FILE_NAME, "wb");
+      ASSERT_NE(nullptr, fp);
+      ASSERT_EQ(size_t(TEST_FILE_SIZE), fwrite(content, 1, TEST_FILE_SIZE, fp));
+      fclose(fp);
+
+      simuFatfsSetPaths(TESTS_BUILD_PATH "/", TESTS_BUILD_PATH "/");
+      ASSERT_EQ(FR_OK, f_open(&file, "/" TEST_FILE_NAME, FA_READ));
+    }
+
+    void TearDown() override
+    {
+      f_close(&file);
+      remove(TESTS_BUILD_PATH "/" TEST_FILE_NAME);
+      simuFatfsSetPaths("", "");
+    }
+};
+
+TEST_F(MultiUpdateTest, pagesWrittenInOrderWhileNextIsRead)
+{
+  LoopbackUpdateDriver driver(&file);
+  EXPECT_EQ(nullptr, driver.writePages(TEST_PAGE_SIZE, 0x1000));
+
+  ASSERT_EQ(4u, driver.pages.size());
+  for (unsigned page = 0; page < driver.pages.size(); page++) {
+    const ProgrammedPage & programmed = driver.pages[page];
+    EXPECT_EQ(0x1000 + page * TEST_PAGE_SIZE / 2, programmed.address);
+    ASSERT_EQ(size_t(TEST_PAGE_SIZE), programmed.data.size());
+    for (unsigned i = 0; i < TEST_PAGE_SIZE; i++) {
+      unsigned offset = page * TEST_PAGE_SIZE + i;
+      // the last page is padded with zeros
+      EXPECT_EQ(offset < TEST_FILE_SIZE ? content[offset] : 0, programmed.data[i]) << "page " << page << " byte " << i;
+    }
+    // the following page is already read when the module answer is checked
+    EXPECT_EQ(std::min<uint32_t>((page + 2) * TEST_PAGE_SIZE, TEST_FILE_SIZE), programmed.filePosAtAnswer);
+  }
+}
+
+TEST_F(MultiUpdateTest, failedPageStopsTransfer)
+{
+  LoopbackUpdateDriver driver(&file, 1);
+  EXPECT_NE(nullptr, driver.writePages(TEST_PAGE_SIZE, 0));
+
+  ASSERT_EQ(2u, driver.pages.size());
+  EXPECT_EQ(0u, driver.pages[0].address);
+  EXPECT_EQ(uint32_t(TEST_PAGE_SIZE / 2), driver.pages[1].address);
+  EXPECT_EQ(0, memcmp(&content[TEST_PAGE_SIZE], driver.pages[1].data.data(), TEST_PAGE_SIZE));
+}
+
+#endif
@@ -242,6 +242,10 @@ static void opencheck (lua_State *L, const char *fname, const char *mode) {
 }
 #endif
 
+#if defined(USE_FATFS)
+void dirCacheInvalidate(void);
+#endif
+
 static int io_open (lua_State *L) {
   const char *filename = luaL_checkstring(L, 1);
   const char *md = luaL_optstring(L, 2, "r");
@@ -254,6 +258,8 @@ static int io_open (lua_State *L) {
     mode = FA_WRITE | FA_OPEN_ALWAYS;       // always open file (create it if necessary) 
   FRESULT result = f_open(&p->f, filename, mode);
   if (result == FR_OK) {
+    if (mode & FA_WRITE)
+      dirCacheInvalidate();                 // the file may be a new one
     if (*md == 'a')
       f_lseek(&p->f, f_size(&p->f));   // seek to the end of the file
     return 1;
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#ifndef _TILT_FILTER_H_
+#define _TILT_FILTER_H_
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+// Angles are fixed point, PI = 1 << 18 (RESX << 8)
+#define TILT_PI                 (1 << 18)
+#define TILT_OUTPUT_SHIFT       8
+// Accelerometer correction weight per sample (1/64)
+#define TILT_ACC_SHIFT          6
+
+/*
+  Complementary filter for one tilt axis: the gyro rate is integrated on each
+  sample and the drift is pulled back towards the angle given by the
+  accelerometer (gravity). Integer only, independent of the IMU driver.
+*/
+class TiltFilter
+{
+  public:
+    // gyroGain: angle units (Q16) per gyro LSB per sample
+    explicit TiltFilter(uint32_t gyroGain):
+      gyroGain(gyroGain)
+    {
+    }
+
+    void reset()
+    {
+      initialized = false;
+      value = 0;
+    }
+
+    // rate: gyro around the tilt axis, accY / accX: accelerometer in the
+    // tilt plane, accValid: false when the acceleration isn't gravity only
+    void update(int32_t rate, int32_t accY, int32_t accX, bool accValid)
+    {
+      if (!initialized) {
+        if (!accValid)
+          return;
+        value = atan2(accY, accX);
+        initialized = true;
+        return;
+      }
+
+      value = wrap(value + (int32_t)(((int64_t)rate * gyroGain + 0x8000) >> 16));
+
+      if (accValid) {
+        int32_t error = wrap(atan2(accY, accX) - value);
+        value = wrap(value + (error >> TILT_ACC_SHIFT));
+      }
+    }
+
+    // RESX (1024) = 180deg
+    int16_t angle() const
+    {
+      return value >> TILT_OUTPUT_SHIFT;
+    }
+
+    // Fixed point atan2, max error 0.25deg
+    static int32_t atan2(int32_t y, int32_t x)
+    {
+      if (x == 0 && y == 0)
+        return 0;
+
+      int32_t ax = abs(x);
+      int32_t ay = abs(y);
+      int32_t result;
+      if (ax >= ay)
+        result = atanQ15(((int64_t)ay << 15) / ax);
+      else
+        result = TILT_PI / 2 - atanQ15(((int64_t)ax << 15) / ay);
+
+      if (x < 0)
+        result = TILT_PI - result;
+      return y < 0 ? -result : result;
+    }
+
+  protected:
+    uint32_t gyroGain;
+    int32_t value = 0;
+    bool initialized = false;
+
+    // atan(z) for z in [0, 1] (Q15): z * PI/4 + 0.273 * z * (1 - z)
+    static int32_t atanQ15(int32_t z)
+    {
+      return z * 2 + (int32_t)(((int64_t)22780 * z * (32768 - z)) >> 30);
+    }
+
+    static int32_t wrap(int32_t angle)
+    {
+      return (int32_t)((uint32_t)(angle + TILT_PI) & (2 * TILT_PI - 1)) - TILT_PI;
+    }
+};
+
+#endif // _TILT_FILTER_H_
@@ -25,6 +25,23 @@ int16_t ppmInput[MAX_TRAINER_CHANNELS];
 uint8_t ppmInputValidityTimer;
 uint8_t currentTrainerMode = 0xff;
 
+volatile uint16_t trainerFrameTime;
+volatile bool trainerFrameNew;
+uint16_t trainerFrameAge;
+uint16_t trainerFrameAgeMax;
+
+// Called by the mixer before it reads ppmInput. The 2MHz timer wraps after
+// 32ms, the age is only meaningful while the mixer runs faster than that
+void checkTrainerFrameAge()
+{
+  if (trainerFrameNew) {
+    trainerFrameNew = false;
+    trainerFrameAge = getTmr2MHz() - trainerFrameTime;
+    if (trainerFrameAge > trainerFrameAgeMax)
+      trainerFrameAgeMax = trainerFrameAge;
+  }
+}
+
 void checkTrainerSignalWarning()
 {
   enum {
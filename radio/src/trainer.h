@@ -39,6 +39,21 @@ void checkTrainerSettings();
 void stopTrainer();
 void forceResetTrainerSettings();
 
+// Trainer frame timing, the frames are timestamped in the ISR which decoded
+// them (2MHz timer), the age is computed when the mixer consumes them
+extern volatile uint16_t trainerFrameTime;
+extern volatile bool trainerFrameNew;
+extern uint16_t trainerFrameAge;
+extern uint16_t trainerFrameAgeMax;
+
+void checkTrainerFrameAge();
+
+inline void trainerFrameReceived()
+{
+  trainerFrameTime = getTmr2MHz();
+  trainerFrameNew = true;
+}
+
 // Needs to be inlined to avoid slow function calls in ISR routines
 inline void captureTrainerPulses(uint16_t capture)
 {
@@ -54,6 +69,9 @@ inline void captureTrainerPulses(uint16_t capture)
   // G: Prioritize reset pulse. (Needed when less than 16 incoming pulses)
   //
   if (val > 4000 && val < 19000) {
+    if (channelNumber > 0) {
+      trainerFrameReceived();
+    }
     channelNumber = 0; // triggered
   }
   else {
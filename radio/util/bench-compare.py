@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Compares two bench-radio JSON results (bench-radio -o results.json)
+# and exits with 1 when a benchmark got slower than the threshold.
+#
+# Usage: bench-compare.py [-t percent] baseline.json results.json
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data, {b["name"]: b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare bench-radio results")
+    parser.add_argument("baseline", help="reference results")
+    parser.add_argument("results", help="new results")
+    parser.add_argument("-t", "--threshold", type=float, default=5.0,
+                        help="regression threshold in %% of the baseline median (default 5)")
+    args = parser.parse_args()
+
+    baseline_data, baseline = load(args.baseline)
+    results_data, results = load(args.results)
+
+    if baseline_data.get("flavour") != results_data.get("flavour"):
+        print("Warning: comparing %s results with %s results" % (results_data.get("flavour"), baseline_data.get("flavour")))
+
+    regressions = 0
+    print("%-40s %12s %12s %8s" % ("benchmark", "base [ns]", "new [ns]", "change"))
+    for name in sorted(set(baseline) | set(results)):
+        if name not in results:
+            print("%-40s %12.1f %12s %8s" % (name, baseline[name]["median_ns"], "-", "removed"))
+            continue
+        if name not in baseline:
+            print("%-40s %12s %12.1f %8s" % (name, "-", results[name]["median_ns"], "new"))
+            continue
+
+        old = baseline[name]
+        new = results[name]
+        change = (new["median_ns"] - old["median_ns"]) * 100.0 / old["median_ns"]
+        # differences within the noise of both runs are not regressions
+        noise = (old["stddev_ns"] + new["stddev_ns"]) * 100.0 / old["median_ns"]
+        flag = ""
+        if change > max(args.threshold, noise):
+            flag = " REGRESSION"
+            regressions += 1
+        elif -change > max(args.threshold, noise):
+            flag = " improved"
+        print("%-40s %12.1f %12.1f %+7.1f%%%s" % (name, old["median_ns"], new["median_ns"], change, flag))
+
+    if regressions:
+        print("%d benchmark(s) slower than %.1f%%" % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())